@@ -0,0 +1,561 @@
+// Microbenchmarks for the traymond_core hot paths.
+//
+// Usage: traymond_bench [--filter=SUBSTR] [--min-time-ms=N] [--repetitions=N]
+//                       [--baseline=FILE] [--max-regression=PCT]
+//
+// Results are printed as JSON on stdout, one benchmark per line, so two runs
+// can be diffed or fed back with --baseline. With a baseline, the comparison
+// goes to stderr and the exit code is 1 if any benchmark regressed by more
+// than --max-regression percent (default 15).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "auto_rules.h"
+#include "config.h"
+#include "hidden_windows.h"
+#include "path_key.h"
+#include "phase_timer.h"
+#include "process_table.h"
+#include "recovery_queue.h"
+#include "state_file.h"
+#include "thrash_guard.h"
+#include "tray_rebuild.h"
+#include "window_batch.h"
+#include "window_reaper.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static const void* volatile g_escape;
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    g_escape = &value;
+    _ReadWriteBarrier();
+}
+#else
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string filter;
+    std::string baseline;
+    double minTimeMs = 200;
+    int repetitions = 5;
+    double maxRegression = 15;
+};
+
+using Counters = std::vector<std::pair<std::string, double>>;
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double nsPerOp;
+    double itemsPerSecond;
+    Counters counters;
+};
+
+class Runner {
+public:
+    explicit Runner(const Options& options) : m_options(options) {}
+
+    // Times fn() (one op = itemsPerOp items); reports the median of the repetitions.
+    // counters are printed with the result, e.g. outcomes of a simulation.
+    template <typename Fn>
+    void Run(const std::string& name, uint64_t itemsPerOp, Fn&& fn, Counters counters = {}) {
+        if (!m_options.filter.empty() && name.find(m_options.filter) == std::string::npos) return;
+
+        // Grow the iteration count until one repetition takes --min-time-ms
+        uint64_t iterations = 1;
+        for (;;) {
+            double ns = TimeLoop(iterations, fn);
+            if (ns >= m_options.minTimeMs * 1e6 || iterations >= (1ull << 40)) break;
+            double scale = ns > 0 ? (m_options.minTimeMs * 1e6 * 1.2) / ns : 100.0;
+            iterations = std::max(iterations + 1, static_cast<uint64_t>(iterations * std::min(scale, 100.0)));
+        }
+
+        std::vector<double> samples;
+        for (int r = 0; r < m_options.repetitions; r++) {
+            samples.push_back(TimeLoop(iterations, fn) / static_cast<double>(iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        double nsPerOp = samples[samples.size() / 2];
+
+        Result result{ name, iterations, nsPerOp, nsPerOp > 0 ? itemsPerOp * 1e9 / nsPerOp : 0.0, std::move(counters) };
+        Print(result);
+        m_results.push_back(result);
+    }
+
+    const std::vector<Result>& Results() const { return m_results; }
+
+private:
+    template <typename Fn>
+    static double TimeLoop(uint64_t iterations, Fn& fn) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; i++) fn();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    void Print(const Result& r) {
+        std::printf("%s    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"items_per_second\": %.1f",
+                    m_results.empty() ? "" : ",\n", r.name.c_str(),
+                    static_cast<unsigned long long>(r.iterations), r.nsPerOp, r.itemsPerSecond);
+        if (!r.counters.empty()) {
+            std::printf(", \"counters\": {");
+            for (size_t i = 0; i < r.counters.size(); i++) {
+                std::printf("%s\"%s\": %.0f", i ? ", " : "", r.counters[i].first.c_str(), r.counters[i].second);
+            }
+            std::printf("}");
+        }
+        std::printf("}");
+        std::fflush(stdout);
+    }
+
+    const Options& m_options;
+    std::vector<Result> m_results;
+};
+
+// --- Realistic Windows path corpus ---
+
+std::u16string Widen(std::string_view s) {
+    return std::u16string(s.begin(), s.end());
+}
+
+std::vector<std::u16string> MakePathCorpus(size_t count, uint32_t seed) {
+    static const char* roots[] = {
+        "C:\\Program Files\\",
+        "C:\\Program Files (x86)\\",
+        "C:\\Users\\Alex\\AppData\\Local\\Programs\\",
+        "C:\\Users\\Alex\\AppData\\Roaming\\",
+        "C:\\Windows\\System32\\",
+        "\\\\?\\C:\\Program Files\\WindowsApps\\Microsoft.WindowsCalculator_11.2210.0.0_x64__8wekyb3d8bbwe\\",
+        "\\\\?\\UNC\\fileserver\\apps\\",
+        "\\\\fileserver\\Shared Tools\\",
+        "\\Device\\HarddiskVolume3\\Tools\\",
+        "D:/Games/Steam/steamapps/common/",
+        "c:\\program files\\\\",
+    };
+    static const char* vendors[] = {
+        "Google", "Mozilla Firefox", "Microsoft Office\\root\\Office16", "JetBrains\\IntelliJ IDEA 2024.1\\bin",
+        "Spotify", "Discord\\app-1.0.9032", "Notepad++", "VideoLAN\\VLC", "Slack", "WhatsApp",
+    };
+    static const char* exes[] = {
+        "chrome.exe", "firefox.exe", "WINWORD.EXE", "idea64.exe", "Spotify.exe",
+        "Discord.exe", "notepad++.exe", "vlc.exe", "slack.exe", "WhatsApp.exe",
+    };
+
+    std::mt19937 rng(seed);
+    std::vector<std::u16string> corpus;
+    corpus.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        std::string path = roots[rng() % std::size(roots)];
+        path += vendors[rng() % std::size(vendors)];
+        path += (rng() % 4 == 0) ? "/" : "\\";
+        path += exes[rng() % std::size(exes)];
+        corpus.push_back(Widen(path));
+    }
+    return corpus;
+}
+
+// --- Backends that do no Win32 work ---
+
+struct NullBatchBackend : BatchBackend {
+    HiddenWindowTable<uint32_t> hidden;
+    uint64_t writes = 0;
+
+    bool AddTrayIcon(uint64_t window) override { return hidden.Insert(window, 0); }
+    bool RemoveTrayIcon(uint64_t window) override { return hidden.Erase(window); }
+    void ApplyWindowOps(const std::vector<WindowOp>& ops) override { DoNotOptimize(ops); }
+    void CommitState() override { writes++; }
+};
+
+// --- Benchmarks ---
+
+void BenchPathKeys(Runner& runner) {
+    auto corpus = MakePathCorpus(1024, 1);
+    for (PathKeyKernel kernel : { PathKeyKernel::Avx2, PathKeyKernel::Sse2, PathKeyKernel::Scalar }) {
+        if (!PathKeyKernelSupported(kernel)) continue;
+        runner.Run(std::string("path_key/normalize_") + PathKeyKernelName(kernel), corpus.size(), [&] {
+            for (const auto& path : corpus) DoNotOptimize(MakePathKeyWith(path, kernel));
+        });
+    }
+}
+
+void BenchRules(Runner& runner) {
+    auto rulePaths = MakePathCorpus(64, 2);
+    AutoMinimizeRules rules;
+    std::vector<AutoListEntry> entries;
+    for (auto& path : rulePaths) entries.push_back({ std::move(path) });
+    rules.Assign(std::move(entries));
+
+    // Same files spelled differently (prefixes, case, separators) must still hit
+    std::vector<std::u16string> hits;
+    for (const auto& path : rules.Paths()) {
+        std::u16string variant = (path.size() > 1 && path[1] == u':') ? u"\\\\?\\" + path : path;
+        std::transform(variant.begin(), variant.end(), variant.begin(),
+                       [](char16_t c) { return c == u'\\' ? u'/' : c; });
+        hits.push_back(variant);
+    }
+    auto misses = MakePathCorpus(256, 3);
+    misses.erase(std::remove_if(misses.begin(), misses.end(),
+                                [&](const std::u16string& p) { return rules.Contains(p); }), misses.end());
+
+    runner.Run("rules/match_hit", hits.size(), [&] {
+        for (const auto& path : hits) DoNotOptimize(rules.Contains(path));
+    });
+    runner.Run("rules/match_miss", misses.size(), [&] {
+        for (const auto& path : misses) DoNotOptimize(rules.Contains(path));
+    });
+}
+
+void BenchHiddenWindows(Runner& runner) {
+    constexpr size_t kWindows = 1000;
+    std::vector<uint64_t> handles;
+    std::mt19937_64 rng(4);
+    for (size_t i = 0; i < kWindows; i++) handles.push_back((rng() & 0xFFFFFFF0ull) | 0x4);
+
+    runner.Run("hidden/insert_1000", kWindows, [&] {
+        HiddenWindowTable<uint64_t> table;
+        for (uint64_t h : handles) table.Insert(h, h);
+        DoNotOptimize(table);
+    });
+
+    HiddenWindowTable<uint64_t> full;
+    for (uint64_t h : handles) full.Insert(h, h);
+    runner.Run("hidden/lookup_1000", kWindows, [&] {
+        for (uint64_t h : handles) DoNotOptimize(full.Find(h));
+    });
+
+    runner.Run("hidden/insert_erase_1000", kWindows, [&] {
+        HiddenWindowTable<uint64_t> table = full;
+        for (uint64_t h : handles) table.Erase(h);
+        DoNotOptimize(table);
+    });
+}
+
+void BenchState(Runner& runner) {
+    std::vector<uint64_t> windows;
+    for (uint64_t i = 0; i < 1000; i++) windows.push_back(0x10000 + i * 0x26);
+    std::string encoded = EncodeHiddenState(windows);
+
+    runner.Run("state/encode_1000", windows.size(), [&] { DoNotOptimize(EncodeHiddenState(windows)); });
+    runner.Run("state/decode_1000", windows.size(), [&] { DoNotOptimize(DecodeHiddenState(encoded)); });
+
+    auto file = std::filesystem::temp_directory_path() / "traymond_bench_state.dat";
+    runner.Run("state/save_load_file_1000", windows.size(), [&] {
+        SaveHiddenState(file, windows);
+        DoNotOptimize(LoadHiddenState(file));
+    });
+    std::error_code ec;
+    std::filesystem::remove(file, ec);
+}
+
+void BenchConfig(Runner& runner) {
+    std::string autoList;
+    for (const auto& path : MakePathCorpus(200, 5)) {
+        for (char16_t c : path) autoList.push_back(static_cast<char>(c));
+        autoList += "\r\n";
+    }
+    runner.Run("config/parse_autolist_200", 200, [&] {
+        AutoMinimizeRules rules;
+        rules.Assign(ParseAutoList(autoList));
+        DoNotOptimize(rules);
+    });
+
+    const std::string hotkeyLines[] = { "12,90,1", "12,65,0" };
+    runner.Run("config/parse_hotkeys", 2, [&] {
+        HotkeyConfig minimize{}, autoAdd{};
+        DoNotOptimize(ParseHotkeyLine(hotkeyLines[0], minimize));
+        DoNotOptimize(ParseHotkeyLine(hotkeyLines[1], autoAdd));
+    });
+}
+
+void BenchReaper(Runner& runner) {
+    // 2000 hidden windows across 500 processes, then every process exits at once
+    constexpr uint32_t kProcesses = 500;
+    constexpr uint64_t kWindows = 2000;
+    auto bulkExit = [&] {
+        WindowReaper reaper;
+        for (uint64_t w = 0; w < kWindows; w++) reaper.Track(0x1000 + w, 100 + static_cast<uint32_t>(w % kProcesses));
+        for (uint32_t p = 0; p < kProcesses; p++) reaper.OnProcessExited(100 + p);
+        DoNotOptimize(reaper.TakeBatch());
+        return reaper.Stats();
+    };
+
+    // Reap latency (mark to flush) of one bulk exit, excluding the message-queue hop of the app
+    ReapStats stats = bulkExit();
+    Counters counters = {
+        { "batches", double(stats.batches) },
+        { "reaped", double(stats.reapedWindows) },
+        { "mean_latency_ns", double(stats.totalLatency.count()) / double(std::max<uint64_t>(stats.reapedWindows, 1)) },
+        { "max_latency_ns", double(stats.maxLatency.count()) },
+    };
+    runner.Run("reaper/bulk_exit_2000", kWindows, bulkExit, std::move(counters));
+}
+
+void BenchBatch(Runner& runner) {
+    constexpr uint64_t kWindows = 500;
+    runner.Run("batch/hide_restore_500", kWindows * 2, [&] {
+        NullBatchBackend backend;
+        WindowBatch batch;
+        for (uint64_t w = 0; w < kWindows; w++) batch.Hide(0x1000 + w);
+        batch.Commit(backend);
+        for (uint64_t w = 0; w < kWindows; w++) batch.Restore(0x1000 + w);
+        batch.Commit(backend);
+        DoNotOptimize(backend.writes);
+    });
+}
+
+void BenchTrayRebuild(Runner& runner) {
+    // Explorer restarted with 500 hidden windows: the fresh shell rejects the
+    // first attempt of every tenth icon and 5 windows go away mid-rebuild.
+    // Steps run every 15 ms of simulated time, like TIMER_TRAY_REBUILD.
+    constexpr uint64_t kIcons = 500;
+    std::vector<uint64_t> icons;
+    for (uint64_t i = 0; i < kIcons; i++) icons.push_back(i);
+
+    auto rebuildOnce = [&] {
+        std::vector<uint8_t> attempts(kIcons, 0);
+        auto now = TrayRebuild::Clock::time_point{} + std::chrono::hours(1);
+        TrayRebuild rebuild;
+        rebuild.Begin(icons, now);
+        auto fakeTray = [&](uint64_t id) {
+            if (id % 100 == 50) return TrayAddResult::Gone;
+            return (id % 10 == 0 && attempts[id]++ == 0) ? TrayAddResult::Failed : TrayAddResult::Added;
+        };
+        while (!rebuild.Step(fakeTray, now)) now += std::chrono::milliseconds(15);
+        return rebuild.Report();
+    };
+
+    TrayRebuildReport report = rebuildOnce();
+    Counters counters = {
+        { "restored", double(report.restored) }, { "failed", double(report.failed) },
+        { "gone", double(report.gone) }, { "steps", double(report.steps) },
+        { "simulated_ms", double(std::chrono::duration_cast<std::chrono::milliseconds>(report.elapsed).count()) },
+    };
+    runner.Run("tray_rebuild/500", kIcons, [&] { DoNotOptimize(rebuildOnce()); }, std::move(counters));
+}
+
+void BenchProcessTree(Runner& runner) {
+    // 5000 processes; each one's parent is a recent earlier process, giving
+    // launcher -> app -> helper chains a handful of levels deep
+    constexpr uint32_t kProcesses = 5000;
+    auto images = MakePathCorpus(kProcesses, 7);
+    std::mt19937 rng(8);
+    auto pickParent = [&](uint32_t pid) -> uint32_t {
+        if (pid <= 4 || rng() % 16 == 0) return 4;  // Direct child of the shell
+        return pid - 4 - 4 * (rng() % std::min<uint32_t>(pid / 4 - 1, 8));
+    };
+
+    ProcessTable table;
+    uint64_t clock = 1;
+    for (uint32_t i = 1; i <= kProcesses; i++) {
+        uint32_t pid = i * 4;
+        table.Upsert(pid, { pickParent(pid), clock++, MakePathKey(images[i - 1]) });
+    }
+
+    // A few launcher-style rules that also cover child processes
+    AutoMinimizeRules rules;
+    auto rulePaths = MakePathCorpus(16, 9);
+    for (size_t i = 0; i < rulePaths.size(); i++) rules.Add(rulePaths[i], i % 4 == 0);
+
+    runner.Run("process_tree/match_5000", kProcesses, [&] {
+        for (uint32_t i = 1; i <= kProcesses; i++) DoNotOptimize(rules.MatchesProcess(table, i * 4));
+    });
+
+    // One overflow trim, as WM_PRUNE_PROCESSES does past the table budget
+    runner.Run("process_tree/evict_lru_5000", kProcesses, [&] {
+        ProcessTable copy = table;
+        DoNotOptimize(copy.EvictLeastRecentlyUsed(kProcesses * 3 / 4));
+    });
+
+    // Exits and pid reuse interleaved with lookups, as the event hook sees them
+    constexpr size_t kOps = 5000;
+    runner.Run("process_tree/churn_5000", kOps, [&] {
+        for (size_t op = 0; op < kOps; op++) {
+            uint32_t pid = 4 * (1 + rng() % kProcesses);
+            if (op % 2 == 0) {
+                table.Remove(pid);
+                table.Upsert(pid, { pickParent(pid), clock++, MakePathKey(images[rng() % images.size()]) });
+            } else {
+                DoNotOptimize(rules.MatchesProcess(table, pid));
+            }
+        }
+    });
+}
+
+// Adversarial re-show simulator on a virtual clock. Every scenario offers
+// auto-minimize attempts every `period` for 60 simulated seconds.
+struct ReshowScenario {
+    const char* name;
+    size_t windows;            // Windows taking turns
+    size_t processes;          // Processes they belong to (round robin)
+    std::chrono::milliseconds period;
+    bool freshHandles;         // Re-created with a new handle each time instead of re-shown
+};
+
+ThrashStats SimulateReshow(const ReshowScenario& scenario, uint64_t* attempts) {
+    using namespace std::chrono;
+    ThrashGuard guard;
+    auto now = ThrashGuard::Clock::time_point{} + hours(1);
+    const auto end = now + seconds(60);
+    uint64_t handle = 0x10000;
+    uint64_t n = 0;
+    for (; now < end; now += scenario.period, n++) {
+        size_t slot = n % scenario.windows;
+        uint64_t window = scenario.freshHandles ? handle++ : 0x1000 + slot;
+        guard.OnHideAttempt(window, 100 + static_cast<uint32_t>(slot % scenario.processes), now);
+        if (n % 1024 == 0) guard.Prune(now);
+    }
+    if (attempts) *attempts = n;
+    return guard.Stats();
+}
+
+void BenchThrashGuard(Runner& runner) {
+    using std::chrono::milliseconds;
+    const ReshowScenario scenarios[] = {
+        { "reshow_16ms", 1, 1, milliseconds(16), false },     // Re-shows right after every hide
+        { "respawn_16ms", 1, 1, milliseconds(16), true },     // New window each time: rate limited, never a strike
+        { "reshow_50_apps", 50, 50, milliseconds(16), false },  // 50 thrashing programs at once
+        { "polite_50_apps", 50, 50, milliseconds(100), false }, // Each window shows every 5 s
+    };
+    for (const auto& scenario : scenarios) {
+        uint64_t attempts = 0;
+        ThrashStats stats = SimulateReshow(scenario, &attempts);
+        Counters counters = {
+            { "attempts", double(attempts) }, { "allowed", double(stats.allowed) },
+            { "backoffs", double(stats.backoffs) }, { "quarantines", double(stats.quarantines) },
+            { "suppressed", double(stats.suppressed) },
+        };
+        runner.Run(std::string("thrash/") + scenario.name, attempts, [&] {
+            DoNotOptimize(SimulateReshow(scenario, nullptr));
+        }, std::move(counters));
+    }
+}
+
+void BenchStartupRecovery(Runner& runner) {
+    // A previous session left 1000 windows hidden; every tenth one has since died
+    constexpr uint64_t kWindows = 1000;
+    constexpr size_t kChunk = 32;
+    std::vector<uint64_t> saved;
+    for (uint64_t i = 0; i < kWindows; i++) saved.push_back(0x1000 + i);
+    auto alive = [](uint64_t window) { return window % 10 != 0; };
+
+    runner.Run("startup/recovery_1000", kWindows, [&] {
+        PhaseTimer trace;
+        NullBatchBackend backend;
+        RecoveryQueue recovery;
+
+        trace.Begin("recovery_read");
+        recovery.Begin(saved);
+        trace.Begin("recovery");
+        bool done = false;
+        while (!done) {
+            WindowBatch batch;
+            done = recovery.Step(kChunk, [&](uint64_t window) {
+                if (alive(window)) batch.Hide(window);
+            });
+            batch.Commit(backend);
+        }
+        trace.End();
+        DoNotOptimize(trace.Total());
+        DoNotOptimize(backend.writes);
+    });
+}
+
+// --- Baseline comparison ---
+
+std::map<std::string, double> LoadBaseline(const std::string& file) {
+    std::map<std::string, double> baseline;
+    std::ifstream in(file);
+    std::string line;
+    while (std::getline(in, line)) {
+        auto name = line.find("\"name\": \"");
+        auto ns = line.find("\"ns_per_op\": ");
+        if (name == std::string::npos || ns == std::string::npos) continue;
+        name += 9;
+        auto nameEnd = line.find('"', name);
+        baseline[line.substr(name, nameEnd - name)] = std::strtod(line.c_str() + ns + 13, nullptr);
+    }
+    return baseline;
+}
+
+bool CompareWithBaseline(const std::vector<Result>& results, const Options& options) {
+    auto baseline = LoadBaseline(options.baseline);
+    bool regressed = false;
+    std::fprintf(stderr, "%-36s %14s %14s %9s\n", "benchmark", "baseline ns", "current ns", "delta");
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0) {
+            std::fprintf(stderr, "%-36s %14s %14.3f %9s\n", r.name.c_str(), "-", r.nsPerOp, "new");
+            continue;
+        }
+        double delta = (r.nsPerOp - it->second) / it->second * 100.0;
+        bool bad = delta > options.maxRegression;
+        regressed |= bad;
+        std::fprintf(stderr, "%-36s %14.3f %14.3f %+8.1f%%%s\n", r.name.c_str(), it->second, r.nsPerOp, delta,
+                     bad ? "  REGRESSION" : "");
+    }
+    return !regressed;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        auto value = [&](std::string_view flag) { return std::string(arg.substr(flag.size())); };
+        if (arg.rfind("--filter=", 0) == 0) options.filter = value("--filter=");
+        else if (arg.rfind("--baseline=", 0) == 0) options.baseline = value("--baseline=");
+        else if (arg.rfind("--min-time-ms=", 0) == 0) options.minTimeMs = std::atof(value("--min-time-ms=").c_str());
+        else if (arg.rfind("--repetitions=", 0) == 0) options.repetitions = std::max(1, std::atoi(value("--repetitions=").c_str()));
+        else if (arg.rfind("--max-regression=", 0) == 0) options.maxRegression = std::atof(value("--max-regression=").c_str());
+        else {
+            std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) return 2;
+
+    std::printf("{\n  \"context\": {\"path_key_kernel\": \"%s\", \"min_time_ms\": %.0f, \"repetitions\": %d},\n"
+                "  \"benchmarks\": [\n", PathKeyKernelName(), options.minTimeMs, options.repetitions);
+
+    Runner runner(options);
+    BenchPathKeys(runner);
+    BenchRules(runner);
+    BenchHiddenWindows(runner);
+    BenchState(runner);
+    BenchConfig(runner);
+    BenchReaper(runner);
+    BenchBatch(runner);
+    BenchTrayRebuild(runner);
+    BenchProcessTree(runner);
+    BenchThrashGuard(runner);
+    BenchStartupRecovery(runner);
+
+    std::printf("\n  ]\n}\n");
+
+    if (!options.baseline.empty() && !CompareWithBaseline(runner.Results(), options)) return 1;
+    return 0;
+}
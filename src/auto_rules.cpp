@@ -0,0 +1,90 @@
+#include "auto_rules.h"
+
+#include <utility>
+
+#include "process_table.h"
+
+void AutoMinimizeRules::Assign(std::vector<AutoListEntry> entries) {
+    Clear();
+    m_paths.reserve(entries.size());
+    m_keys.reserve(entries.size());
+    m_includeChildren.reserve(entries.size());
+    for (auto& entry : entries) {
+        Add(std::move(entry.path), entry.includeChildren);
+    }
+}
+
+bool AutoMinimizeRules::Add(std::u16string path, bool includeChildren) {
+    PathKey key = MakePathKey(path);
+    if (Matches(key)) return false;
+
+    m_byHash.emplace(key.hash, m_paths.size());
+    m_paths.push_back(std::move(path));
+    m_keys.push_back(std::move(key));
+    m_includeChildren.push_back(includeChildren);
+    if (includeChildren) m_treeRules++;
+    return true;
+}
+
+void AutoMinimizeRules::RemoveAt(size_t index) {
+    if (index >= m_paths.size()) return;
+    if (m_includeChildren[index]) m_treeRules--;
+    m_paths.erase(m_paths.begin() + index);
+    m_keys.erase(m_keys.begin() + index);
+    m_includeChildren.erase(m_includeChildren.begin() + index);
+    RebuildIndex();
+}
+
+void AutoMinimizeRules::SetIncludeChildren(size_t index, bool includeChildren) {
+    if (index >= m_paths.size() || m_includeChildren[index] == includeChildren) return;
+    m_includeChildren[index] = includeChildren;
+    if (includeChildren) {
+        m_treeRules++;
+    } else {
+        m_treeRules--;
+    }
+}
+
+void AutoMinimizeRules::Clear() {
+    m_paths.clear();
+    m_keys.clear();
+    m_includeChildren.clear();
+    m_byHash.clear();
+    m_treeRules = 0;
+}
+
+bool AutoMinimizeRules::Matches(const PathKey& key) const {
+    return Find(key) >= 0;
+}
+
+bool AutoMinimizeRules::MatchesTree(const PathKey& key) const {
+    if (m_treeRules == 0) return false;
+    ptrdiff_t index = Find(key);
+    return index >= 0 && m_includeChildren[index];
+}
+
+bool AutoMinimizeRules::MatchesProcess(const ProcessTable& processes, uint32_t pid) const {
+    const ProcessRecord* record = processes.Find(pid);
+    if (!record) return false;
+    if (Matches(record->image)) return true;
+    if (m_treeRules == 0) return false;
+
+    return processes.AnyAncestor(pid, [this](uint32_t, const ProcessRecord& ancestor) {
+        return MatchesTree(ancestor.image);
+    });
+}
+
+ptrdiff_t AutoMinimizeRules::Find(const PathKey& key) const {
+    auto [first, last] = m_byHash.equal_range(key.hash);
+    for (auto it = first; it != last; ++it) {
+        if (m_keys[it->second].canonical == key.canonical) return static_cast<ptrdiff_t>(it->second);
+    }
+    return -1;
+}
+
+void AutoMinimizeRules::RebuildIndex() {
+    m_byHash.clear();
+    for (size_t i = 0; i < m_keys.size(); i++) {
+        m_byHash.emplace(m_keys[i].hash, i);
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+// The auto-minimize list: executable paths as the user entered them, plus an
+// index of their canonical keys so matching a window's process is one hash
+// lookup instead of a scan with string compares. Rules flagged
+// includeChildren also match processes started (directly or not) by the
+// listed executable.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "config.h"
+#include "path_key.h"
+
+class ProcessTable;
+
+class AutoMinimizeRules {
+public:
+    // Replaces the list; paths equivalent to an earlier entry are dropped
+    void Assign(std::vector<AutoListEntry> entries);
+
+    // False if an equivalent path is already in the list
+    bool Add(std::u16string path, bool includeChildren = false);
+    void RemoveAt(size_t index);
+    void Clear();
+
+    bool Contains(std::u16string_view path) const { return Matches(MakePathKey(path)); }
+    bool Matches(const PathKey& key) const;
+    // Only rules flagged includeChildren
+    bool MatchesTree(const PathKey& key) const;
+    // pid's own image matches any rule, or one of its ancestors matches an includeChildren rule
+    bool MatchesProcess(const ProcessTable& processes, uint32_t pid) const;
+
+    size_t Size() const { return m_paths.size(); }
+    bool Empty() const { return m_paths.empty(); }
+    const std::u16string& PathAt(size_t index) const { return m_paths[index]; }
+    const std::vector<std::u16string>& Paths() const { return m_paths; }
+    bool IncludesChildren(size_t index) const { return m_includeChildren[index]; }
+    void SetIncludeChildren(size_t index, bool includeChildren);
+    bool HasTreeRules() const { return m_treeRules > 0; }
+
+private:
+    void RebuildIndex();
+    // Index of the rule equivalent to key, or -1
+    ptrdiff_t Find(const PathKey& key) const;
+
+    std::vector<std::u16string> m_paths;
+    std::vector<PathKey> m_keys;
+    std::vector<bool> m_includeChildren;
+    size_t m_treeRules = 0;
+    std::unordered_multimap<uint64_t, size_t> m_byHash;
+};
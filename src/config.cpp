@@ -0,0 +1,59 @@
+#include "config.h"
+
+#include <charconv>
+#include <utility>
+
+namespace {
+
+bool ParseField(std::string_view& text, long long& value) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc()) return false;
+    text.remove_prefix(ptr - text.data());
+    return true;
+}
+
+bool ParseSeparator(std::string_view& text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    if (text.empty() || text.front() != ',') return false;
+    text.remove_prefix(1);
+    return true;
+}
+
+} // namespace
+
+bool ParseHotkeyLine(std::string_view line, HotkeyConfig& out) {
+    long long mods, vk, enabled;
+    if (!ParseField(line, mods) || !ParseSeparator(line) ||
+        !ParseField(line, vk) || !ParseSeparator(line) ||
+        !ParseField(line, enabled)) {
+        return false;
+    }
+    out = { static_cast<uint32_t>(mods), static_cast<uint32_t>(vk), enabled != 0 };
+    return true;
+}
+
+std::string FormatHotkeyLine(const HotkeyConfig& hotkey) {
+    return std::to_string(hotkey.modifiers) + "," + std::to_string(hotkey.vk) + "," + (hotkey.enabled ? "1" : "0");
+}
+
+std::vector<AutoListEntry> ParseAutoList(std::string_view bytes) {
+    std::vector<AutoListEntry> entries;
+    std::u16string line;
+    for (size_t pos = 0; pos <= bytes.size(); pos++) {
+        if (pos == bytes.size() || bytes[pos] == '\n') {
+            bool includeChildren = !line.empty() && line.front() == AUTO_LIST_CHILDREN_PREFIX;
+            if (includeChildren) line.erase(0, 1);
+            if (!line.empty()) entries.push_back({ std::move(line), includeChildren });
+            line.clear();
+        } else if (bytes[pos] != '\r') {
+            line.push_back(static_cast<unsigned char>(bytes[pos]));
+        }
+    }
+    return entries;
+}
+
+std::u16string FormatAutoListLine(const AutoListEntry& entry) {
+    if (!entry.includeChildren) return entry.path;
+    return AUTO_LIST_CHILDREN_PREFIX + entry.path;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Parsing of the plain-text settings files (traymond_auto.txt, traymond_hotkeys.txt)
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Hotkey configuration (modifier | virtualKey, 0 means disabled)
+struct HotkeyConfig {
+    uint32_t modifiers;
+    uint32_t vk;
+    bool enabled;
+};
+
+// One "modifiers,vk,enabled" line. Leaves out untouched and returns false if malformed.
+bool ParseHotkeyLine(std::string_view line, HotkeyConfig& out);
+std::string FormatHotkeyLine(const HotkeyConfig& hotkey);
+
+// One auto-minimize rule. includeChildren also matches windows of any
+// descendant process (launchers, Electron/Chromium helpers).
+struct AutoListEntry {
+    std::u16string path;
+    bool includeChildren = false;
+};
+
+// Marks an includeChildren rule in traymond_auto.txt ('>' cannot occur in a Windows path)
+constexpr char16_t AUTO_LIST_CHILDREN_PREFIX = u'>';
+
+// traymond_auto.txt is written one byte per character (the C locale of
+// std::wofstream), one rule per line. CR characters and empty lines are dropped.
+std::vector<AutoListEntry> ParseAutoList(std::string_view bytes);
+// One line of traymond_auto.txt (without the newline), as ParseAutoList reads it back
+std::u16string FormatAutoListLine(const AutoListEntry& entry);
@@ -0,0 +1,83 @@
+#pragma once
+
+// Table of hidden windows keyed by window handle value. Insert, lookup and
+// erase are O(1); erase swaps the last entry into the hole, so iteration
+// order is not insertion order.
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class HiddenWindowTable {
+public:
+    struct Entry {
+        uint64_t window;
+        T value;
+    };
+
+    // False (and no change) if the window is already hidden
+    bool Insert(uint64_t window, T value) {
+        auto [it, inserted] = m_index.try_emplace(window, m_entries.size());
+        if (!inserted) return false;
+        m_entries.push_back({ window, std::move(value) });
+        return true;
+    }
+
+    T* Find(uint64_t window) {
+        auto it = m_index.find(window);
+        return it == m_index.end() ? nullptr : &m_entries[it->second].value;
+    }
+
+    const T* Find(uint64_t window) const {
+        auto it = m_index.find(window);
+        return it == m_index.end() ? nullptr : &m_entries[it->second].value;
+    }
+
+    bool Contains(uint64_t window) const { return m_index.count(window) > 0; }
+
+    bool Erase(uint64_t window) {
+        auto it = m_index.find(window);
+        if (it == m_index.end()) return false;
+
+        size_t slot = it->second;
+        m_index.erase(it);
+        if (slot + 1 != m_entries.size()) {
+            m_entries[slot] = std::move(m_entries.back());
+            m_index[m_entries[slot].window] = slot;
+        }
+        m_entries.pop_back();
+        return true;
+    }
+
+    void Clear() {
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    void Reserve(size_t count) {
+        m_entries.reserve(count);
+        m_index.reserve(count);
+    }
+
+    std::vector<uint64_t> Windows() const {
+        std::vector<uint64_t> windows;
+        windows.reserve(m_entries.size());
+        for (const auto& e : m_entries) windows.push_back(e.window);
+        return windows;
+    }
+
+    size_t Size() const { return m_entries.size(); }
+    bool Empty() const { return m_entries.empty(); }
+
+    auto begin() { return m_entries.begin(); }
+    auto end() { return m_entries.end(); }
+    auto begin() const { return m_entries.begin(); }
+    auto end() const { return m_entries.end(); }
+
+private:
+    std::vector<Entry> m_entries;
+    std::unordered_map<uint64_t, size_t> m_index;
+};
@@ -0,0 +1,308 @@
+#include "path_key.h"
+
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define TRAYMOND_PATHKEY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// MSVC compiles AVX2 intrinsics anywhere; GCC, Clang and clang-cl need them enabled per function
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TRAYMOND_TARGET_AVX2
+#else
+#define TRAYMOND_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+constexpr char16_t kSep = u'\\';
+
+inline bool IsSeparator(char16_t c) { return c == u'\\' || c == u'/'; }
+
+inline char16_t FoldUnit(char16_t c) {
+    if (c == u'/') return kSep;
+    if (c >= u'A' && c <= u'Z') return static_cast<char16_t>(c + 0x20);
+    if (c >= 0xC0 && c <= 0xDE && c != 0xD7) return static_cast<char16_t>(c + 0x20);
+    return c;
+}
+
+// Hash over the canonical form, consumed four code units (one 64-bit word) at a time
+constexpr uint64_t kHashSeed = 0x6A09E667F3BCC909ull;
+
+inline uint64_t MixWord(uint64_t h, uint64_t word) {
+    h ^= word * 0x9E3779B97F4A7C15ull;
+    h = (h << 29) | (h >> 35);
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+inline uint64_t LoadUnits(const char16_t* p, size_t count) {
+    uint64_t word = 0;
+    std::memcpy(&word, p, count * sizeof(char16_t));
+    return word;
+}
+
+inline uint64_t FinalizeHash(uint64_t h, size_t length) {
+    h ^= length;
+    h ^= h >> 31;
+    h *= 0x94D049BB133111EBull;
+    h ^= h >> 29;
+    return h;
+}
+
+// Writes the canonical form and hashes every word that can no longer change.
+// The last unit is held back until Finish() because a trailing separator may be dropped.
+struct Emitter {
+    char16_t* base;
+    char16_t* out;
+    size_t hashed = 0;
+    uint64_t hash = kHashSeed;
+    bool prevSep = false;
+
+    void Push(char16_t c) {
+        c = FoldUnit(c);
+        if (c == kSep) {
+            if (prevSep) return;
+            prevSep = true;
+        } else {
+            prevSep = false;
+        }
+        *out++ = c;
+    }
+
+    void HashCompleted() {
+        size_t length = out - base;
+        while (length - hashed > 4) {
+            hash = MixWord(hash, LoadUnits(base + hashed, 4));
+            hashed += 4;
+        }
+    }
+
+    size_t Finish() {
+        size_t length = out - base;
+        bool driveRoot = length == 3 && base[1] == u':';
+        bool uncRoot = length == 2 && base[0] == kSep;
+        if (length >= 2 && base[length - 1] == kSep && !driveRoot && !uncRoot) length--;
+
+        for (; length - hashed >= 4; hashed += 4) hash = MixWord(hash, LoadUnits(base + hashed, 4));
+        if (length > hashed) hash = MixWord(hash, LoadUnits(base + hashed, length - hashed));
+        hash = FinalizeHash(hash, length);
+        return length;
+    }
+};
+
+// Strips namespace prefixes and emits a leading UNC "\\". Returns where the body starts.
+size_t EmitPrefix(std::u16string_view path, Emitter& e) {
+    const size_t n = path.size();
+    auto sepAt = [&](size_t i) { return i < n && IsSeparator(path[i]); };
+    auto driveAt = [&](size_t i) {
+        return i + 1 < n && FoldUnit(path[i]) >= u'a' && FoldUnit(path[i]) <= u'z' && path[i + 1] == u':';
+    };
+
+    size_t i = 0;
+    if (sepAt(0) && sepAt(1) && n >= 4 && (path[2] == u'?' || path[2] == u'.') && sepAt(3)) {
+        if (path[2] == u'?' && n >= 8 && FoldUnit(path[4]) == u'u' && FoldUnit(path[5]) == u'n' &&
+            FoldUnit(path[6]) == u'c' && sepAt(7)) {
+            // "\\?\UNC\server" -> "\\server"
+            *e.out++ = kSep;
+            *e.out++ = kSep;
+            e.prevSep = true;
+            return 8;
+        }
+        // "\\.\pipe\..." and other non-drive devices keep their prefix
+        if (path[2] == u'?' || driveAt(4)) i = 4;
+    } else if (sepAt(0) && n >= 4 && path[1] == u'?' && path[2] == u'?' && sepAt(3)) {
+        i = 4; // NT object namespace "\??\"
+    }
+
+    if (sepAt(i) && sepAt(i + 1)) {
+        *e.out++ = kSep;
+        *e.out++ = kSep;
+        e.prevSep = true;
+        i += 2;
+    }
+    return i;
+}
+
+using ChunkKernel = void (*)(const char16_t*& in, const char16_t* end, Emitter& e);
+
+#if TRAYMOND_PATHKEY_X86
+
+void RunSse2(const char16_t*& in, const char16_t* end, Emitter& e) {
+    const __m128i slash = _mm_set1_epi16(u'/');
+    const __m128i backslash = _mm_set1_epi16(u'\\');
+    const __m128i upperLo = _mm_set1_epi16(u'A' - 1);
+    const __m128i upperHi = _mm_set1_epi16(u'Z' + 1);
+    const __m128i latinLo = _mm_set1_epi16(0xBF);
+    const __m128i latinHi = _mm_set1_epi16(0xDF);
+    const __m128i times = _mm_set1_epi16(0xD7);
+    const __m128i caseBit = _mm_set1_epi16(0x20);
+
+    while (end - in >= 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        __m128i isSlash = _mm_cmpeq_epi16(v, slash);
+        v = _mm_or_si128(_mm_andnot_si128(isSlash, v), _mm_and_si128(isSlash, backslash));
+
+        // Signed compares are fine: units >= 0x8000 look negative and never fold
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi16(v, upperLo), _mm_cmplt_epi16(v, upperHi));
+        __m128i latin = _mm_andnot_si128(_mm_cmpeq_epi16(v, times),
+                                         _mm_and_si128(_mm_cmpgt_epi16(v, latinLo), _mm_cmplt_epi16(v, latinHi)));
+        v = _mm_add_epi16(v, _mm_and_si128(_mm_or_si128(upper, latin), caseBit));
+
+        // Two mask bits per unit; adjacent separators need the scalar collapse
+        unsigned sep = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi16(v, backslash)));
+        if ((sep & (sep >> 2)) || (e.prevSep && (sep & 1))) {
+            for (int k = 0; k < 8; k++) e.Push(in[k]);
+        } else {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(e.out), v);
+            e.out += 8;
+            e.prevSep = (sep & 0x8000u) != 0;
+        }
+        in += 8;
+        e.HashCompleted();
+    }
+}
+
+TRAYMOND_TARGET_AVX2 void RunAvx2(const char16_t*& in, const char16_t* end, Emitter& e) {
+    const __m256i slash = _mm256_set1_epi16(u'/');
+    const __m256i backslash = _mm256_set1_epi16(u'\\');
+    const __m256i upperLo = _mm256_set1_epi16(u'A' - 1);
+    const __m256i upperHi = _mm256_set1_epi16(u'Z' + 1);
+    const __m256i latinLo = _mm256_set1_epi16(0xBF);
+    const __m256i latinHi = _mm256_set1_epi16(0xDF);
+    const __m256i times = _mm256_set1_epi16(0xD7);
+    const __m256i caseBit = _mm256_set1_epi16(0x20);
+
+    while (end - in >= 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+        __m256i isSlash = _mm256_cmpeq_epi16(v, slash);
+        v = _mm256_blendv_epi8(v, backslash, isSlash);
+
+        __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi16(v, upperLo), _mm256_cmpgt_epi16(upperHi, v));
+        __m256i latin = _mm256_andnot_si256(_mm256_cmpeq_epi16(v, times),
+                                            _mm256_and_si256(_mm256_cmpgt_epi16(v, latinLo), _mm256_cmpgt_epi16(latinHi, v)));
+        v = _mm256_add_epi16(v, _mm256_and_si256(_mm256_or_si256(upper, latin), caseBit));
+
+        uint32_t sep = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(v, backslash)));
+        if ((sep & (sep >> 2)) || (e.prevSep && (sep & 1))) {
+            for (int k = 0; k < 16; k++) e.Push(in[k]);
+        } else {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(e.out), v);
+            e.out += 16;
+            e.prevSep = (sep & 0x80000000u) != 0;
+        }
+        in += 16;
+        e.HashCompleted();
+    }
+}
+
+bool CpuHasAvx2() {
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+    __cpuid(regs, 1);
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // TRAYMOND_PATHKEY_X86
+
+PathKey RunKernel(std::u16string_view path, ChunkKernel kernel) {
+    PathKey key;
+    key.canonical.resize(path.size());
+
+    Emitter e;
+    e.base = key.canonical.data();
+    e.out = e.base;
+
+    const char16_t* in = path.data() + EmitPrefix(path, e);
+    const char16_t* end = path.data() + path.size();
+    if (kernel) kernel(in, end, e);
+    while (in < end) e.Push(*in++);
+
+    key.canonical.resize(e.Finish());
+    key.hash = e.hash;
+    return key;
+}
+
+struct Dispatch {
+    bool hasSse2 = false;
+    bool hasAvx2 = false;
+    PathKeyKernel best = PathKeyKernel::Scalar;
+
+    Dispatch() {
+#if TRAYMOND_PATHKEY_X86
+        hasSse2 = true;
+        hasAvx2 = CpuHasAvx2();
+        best = hasAvx2 ? PathKeyKernel::Avx2 : PathKeyKernel::Sse2;
+#endif
+    }
+};
+
+const Dispatch& GetDispatch() {
+    static const Dispatch dispatch;
+    return dispatch;
+}
+
+ChunkKernel ChunkKernelFor(PathKeyKernel kernel) {
+#if TRAYMOND_PATHKEY_X86
+    if (kernel == PathKeyKernel::Avx2 && GetDispatch().hasAvx2) return RunAvx2;
+    if (kernel == PathKeyKernel::Sse2 && GetDispatch().hasSse2) return RunSse2;
+#else
+    (void)kernel;
+#endif
+    return nullptr;
+}
+
+} // namespace
+
+PathKey MakePathKey(std::u16string_view path) {
+    return RunKernel(path, ChunkKernelFor(GetDispatch().best));
+}
+
+PathKey MakePathKeyWith(std::u16string_view path, PathKeyKernel kernel) {
+    return RunKernel(path, ChunkKernelFor(kernel));
+}
+
+PathKey MakePathKeyScalar(std::u16string_view path) {
+    return RunKernel(path, nullptr);
+}
+
+bool PathKeyKernelSupported(PathKeyKernel kernel) {
+    switch (kernel) {
+    case PathKeyKernel::Scalar: return true;
+    case PathKeyKernel::Sse2: return GetDispatch().hasSse2;
+    case PathKeyKernel::Avx2: return GetDispatch().hasAvx2;
+    }
+    return false;
+}
+
+uint64_t HashPathKey(std::u16string_view canonical) {
+    uint64_t hash = kHashSeed;
+    size_t i = 0;
+    for (; canonical.size() - i >= 4; i += 4) hash = MixWord(hash, LoadUnits(canonical.data() + i, 4));
+    if (canonical.size() > i) hash = MixWord(hash, LoadUnits(canonical.data() + i, canonical.size() - i));
+    return FinalizeHash(hash, canonical.size());
+}
+
+const char* PathKeyKernelName(PathKeyKernel kernel) {
+    switch (kernel) {
+    case PathKeyKernel::Scalar: return "scalar";
+    case PathKeyKernel::Sse2: return "sse2";
+    case PathKeyKernel::Avx2: return "avx2";
+    }
+    return "scalar";
+}
+
+const char* PathKeyKernelName() {
+    return PathKeyKernelName(GetDispatch().best);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+// Canonical, case-folded form of a Windows path plus its hash, computed in one
+// pass over UTF-16 input (SSE2/AVX2 when available, scalar otherwise).
+//
+// Canonicalization:
+//   - "\\?\UNC\server\share" -> "\\server\share"
+//   - "\\?\C:\...", "\??\C:\..." and "\\.\C:\..." -> "C:\..."
+//   - '/' becomes '\', runs of separators collapse to one (a leading UNC "\\" is kept)
+//   - a trailing separator is dropped, except for roots such as "c:\"
+//
+// Case folding is locale-independent and exactly:
+//   - U+0041..U+005A (A-Z)                 -> +0x20
+//   - U+00C0..U+00DE except U+00D7 (x sign) -> +0x20
+//   - every other code unit, including surrogates, is left unchanged
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+struct PathKey {
+    std::u16string canonical;
+    uint64_t hash = 0;
+
+    bool operator==(const PathKey& other) const {
+        return hash == other.hash && canonical == other.canonical;
+    }
+};
+
+enum class PathKeyKernel {
+    Scalar,
+    Sse2,
+    Avx2,
+};
+
+// Fastest kernel the CPU supports
+PathKey MakePathKey(std::u16string_view path);
+
+// A specific kernel, for tests and benchmarks. Every kernel must produce
+// identical results; an unsupported one falls back to scalar.
+PathKey MakePathKeyWith(std::u16string_view path, PathKeyKernel kernel);
+PathKey MakePathKeyScalar(std::u16string_view path);
+
+// True if this build and CPU can run the kernel
+bool PathKeyKernelSupported(PathKeyKernel kernel);
+
+// Hash used by every kernel, defined over the canonical form
+uint64_t HashPathKey(std::u16string_view canonical);
+
+// "avx2", "sse2" or "scalar"; without an argument, the kernel MakePathKey dispatches to
+const char* PathKeyKernelName(PathKeyKernel kernel);
+const char* PathKeyKernelName();
@@ -0,0 +1,40 @@
+#include "phase_timer.h"
+
+#include <cstdio>
+#include <utility>
+
+void PhaseTimer::Begin(std::string name, Clock::time_point now) {
+    if (!m_enabled) return;
+    End(now);
+
+    auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_origin);
+    m_phases.push_back({ std::move(name), offset, std::chrono::nanoseconds(0) });
+    m_phaseStart = now;
+    m_inPhase = true;
+}
+
+void PhaseTimer::End(Clock::time_point now) {
+    if (!m_enabled || !m_inPhase) return;
+    m_phases.back().duration = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_phaseStart);
+    m_inPhase = false;
+}
+
+std::chrono::nanoseconds PhaseTimer::Total() const {
+    std::chrono::nanoseconds total(0);
+    for (const auto& phase : m_phases) total += phase.duration;
+    return total;
+}
+
+std::string PhaseTimer::Format() const {
+    auto ms = [](std::chrono::nanoseconds ns) { return ns.count() / 1e6; };
+
+    std::string text;
+    char line[160];
+    for (const auto& phase : m_phases) {
+        std::snprintf(line, sizeof(line), "%10.3f ms %10.3f ms  %s\n", ms(phase.offset), ms(phase.duration), phase.name.c_str());
+        text += line;
+    }
+    std::snprintf(line, sizeof(line), "%10s    %10.3f ms  total\n", "", ms(Total()));
+    text += line;
+    return text;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+// Records named, sequential phases (e.g. the steps of TraymondApp::Initialize)
+// with their offset from the start of the trace and their duration.
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class PhaseTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Phase {
+        std::string name;
+        std::chrono::nanoseconds offset;   // From construction to the start of the phase
+        std::chrono::nanoseconds duration;
+    };
+
+    // A disabled timer records nothing, so call sites need no checks
+    explicit PhaseTimer(bool enabled = true, Clock::time_point now = Clock::now())
+        : m_enabled(enabled), m_origin(now) {}
+
+    // Starts a phase, ending the current one if any
+    void Begin(std::string name, Clock::time_point now = Clock::now());
+    void End(Clock::time_point now = Clock::now());
+
+    bool Enabled() const { return m_enabled; }
+    bool InPhase() const { return m_inPhase; }
+    const std::vector<Phase>& Phases() const { return m_phases; }
+
+    // Sum of the recorded phase durations (gaps between phases excluded)
+    std::chrono::nanoseconds Total() const;
+
+    // One "offset duration name" line per phase, in milliseconds, plus a total line
+    std::string Format() const;
+
+private:
+    bool m_enabled;
+    bool m_inPhase = false;
+    Clock::time_point m_origin;
+    Clock::time_point m_phaseStart;
+    std::vector<Phase> m_phases;
+};
@@ -0,0 +1,60 @@
+#include "process_table.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+void ProcessTable::Upsert(uint32_t pid, ProcessRecord record) {
+    m_processes.insert_or_assign(pid, Entry{ std::move(record), ++m_useClock });
+}
+
+bool ProcessTable::Remove(uint32_t pid) {
+    return m_processes.erase(pid) > 0;
+}
+
+bool ProcessTable::Touch(uint32_t pid) {
+    auto it = m_processes.find(pid);
+    if (it == m_processes.end()) return false;
+    it->second.lastUsed = ++m_useClock;
+    return true;
+}
+
+const ProcessRecord* ProcessTable::Find(uint32_t pid) const {
+    auto it = m_processes.find(pid);
+    return it == m_processes.end() ? nullptr : &it->second.record;
+}
+
+bool ProcessTable::AnyAncestor(uint32_t pid, const Visitor& visit, size_t maxDepth) const {
+    const ProcessRecord* current = Find(pid);
+    for (size_t depth = 0; current && depth < maxDepth; depth++) {
+        uint32_t parentPid = current->parentPid;
+        const ProcessRecord* parent = ParentOf(pid, *current);
+        if (!parent) return false;
+        if (visit(parentPid, *parent)) return true;
+        pid = parentPid;
+        current = parent;
+    }
+    return false;
+}
+
+size_t ProcessTable::EvictLeastRecentlyUsed(size_t keep) {
+    if (m_processes.size() <= keep) return 0;
+
+    // Use stamps are unique, so the cutoff splits the table exactly
+    std::vector<uint64_t> stamps;
+    stamps.reserve(m_processes.size());
+    for (const auto& [pid, entry] : m_processes) stamps.push_back(entry.lastUsed);
+    size_t evict = m_processes.size() - keep;
+    std::nth_element(stamps.begin(), stamps.begin() + (evict - 1), stamps.end());
+    uint64_t cutoff = stamps[evict - 1];
+
+    return std::erase_if(m_processes, [cutoff](const auto& item) { return item.second.lastUsed <= cutoff; });
+}
+
+const ProcessRecord* ProcessTable::ParentOf(uint32_t pid, const ProcessRecord& record) const {
+    if (record.parentPid == 0 || record.parentPid == pid) return nullptr;
+
+    const ProcessRecord* parent = Find(record.parentPid);
+    if (!parent || parent->startTime > record.startTime) return nullptr;
+    return parent;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// In-memory process table with parent links, filled in and updated one
+// process at a time (no full snapshot per event). Ancestor walks are
+// O(depth) hash lookups.
+//
+// Windows reuses pids, so every record carries its process start time. A
+// parent that started after its child cannot be the real parent (the real
+// one exited and its pid was recycled), so ancestor walks stop there.
+//
+// Records of exited processes stay useful (a launcher that already exited is
+// still the ancestor of its app), so nothing is dropped on exit. Instead every
+// record remembers when it was last used, and EvictLeastRecentlyUsed trims the
+// table in one O(n) pass once it outgrows its budget.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include "path_key.h"
+
+struct ProcessRecord {
+    uint32_t parentPid = 0;
+    uint64_t startTime = 0;  // Any monotonic creation timestamp (FILETIME on Windows)
+    PathKey image;
+};
+
+class ProcessTable {
+public:
+    static constexpr size_t kMaxDepth = 32;
+
+    using Visitor = std::function<bool(uint32_t pid, const ProcessRecord& record)>;
+
+    // Inserts or replaces (and marks used); a different start time for a known pid means the pid was reused
+    void Upsert(uint32_t pid, ProcessRecord record);
+    bool Remove(uint32_t pid);
+    void Clear() { m_processes.clear(); }
+
+    // Marks a record as used so eviction keeps it; false if pid is unknown
+    bool Touch(uint32_t pid);
+
+    const ProcessRecord* Find(uint32_t pid) const;
+    size_t Size() const { return m_processes.size(); }
+
+    // Calls visit for each ancestor of pid, nearest first, until it returns true.
+    // Returns false once the chain ends (root, unknown parent, reused pid or maxDepth).
+    bool AnyAncestor(uint32_t pid, const Visitor& visit, size_t maxDepth = kMaxDepth) const;
+
+    // Drops the least recently used records until at most keep remain; returns how many
+    size_t EvictLeastRecentlyUsed(size_t keep);
+
+private:
+    struct Entry {
+        ProcessRecord record;
+        uint64_t lastUsed;
+    };
+
+    // Parent record of (pid, record), or nullptr if the chain ends there
+    const ProcessRecord* ParentOf(uint32_t pid, const ProcessRecord& record) const;
+
+    std::unordered_map<uint32_t, Entry> m_processes;
+    uint64_t m_useClock = 0;
+};
@@ -0,0 +1,56 @@
+#include "recovery_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+void RecoveryQueue::Begin(std::vector<uint64_t> windows) {
+    m_windows = std::move(windows);
+    m_cursor = 0;
+    m_recovered = 0;
+}
+
+bool RecoveryQueue::Step(size_t budget, const std::function<void(uint64_t)>& visit) {
+    size_t end = std::min(m_windows.size(), m_cursor + budget);
+    while (m_cursor < end) {
+        visit(m_windows[m_cursor++]);
+    }
+    return !Active();
+}
+
+RecoveryStep RecoveryQueue::StepBatch(size_t budget, BatchBackend& backend,
+                                      const std::function<bool(uint64_t)>& canHide) {
+    WindowBatch batch;
+    RecoveryStep step;
+    step.done = Step(budget, [&](uint64_t window) {
+        if (canHide(window)) batch.Hide(window);
+    });
+    step.hidden = batch.Commit(backend).hidden;
+    m_recovered += step.hidden;
+    // A chunk of dead windows hides nothing, but they must still leave the state file
+    if (step.hidden == 0) backend.CommitState();
+    return step;
+}
+
+BatchResult RecoveryQueue::RestoreAll(WindowBatch& batch, BatchBackend& backend,
+                                      const std::function<bool(uint64_t)>& exists) {
+    bool cleared = Active();
+    for (size_t i = m_cursor; i < m_windows.size(); i++) {
+        if (exists(m_windows[i])) batch.Restore(m_windows[i]);
+    }
+    // Recovered() keeps counting for the end-of-recovery notice
+    m_windows.clear();
+    m_cursor = 0;
+
+    BatchResult result = batch.Commit(backend);
+    if (cleared && result.hidden + result.restored + result.forgotten == 0) backend.CommitState();
+    return result;
+}
+
+std::vector<uint64_t> RecoveryQueue::Remaining() const {
+    return std::vector<uint64_t>(m_windows.begin() + m_cursor, m_windows.end());
+}
+
+std::vector<uint64_t> RecoveryQueue::WithRemaining(std::vector<uint64_t> hidden) const {
+    hidden.insert(hidden.end(), m_windows.begin() + m_cursor, m_windows.end());
+    return hidden;
+}
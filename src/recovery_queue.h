@@ -0,0 +1,49 @@
+#pragma once
+
+// Windows left hidden by a previous session, re-minimized a few at a time
+// from the message loop so startup never blocks on them.
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "window_batch.h"
+
+struct RecoveryStep {
+    size_t hidden = 0;  // Windows re-minimized by this chunk
+    bool done = false;  // The queue is drained
+};
+
+class RecoveryQueue {
+public:
+    void Begin(std::vector<uint64_t> windows);
+
+    // Hands up to budget windows to visit. Returns true once the queue is drained.
+    bool Step(size_t budget, const std::function<void(uint64_t)>& visit);
+
+    // One recovery chunk: hides the next budget windows that canHide accepts in one batch.
+    // The state file is rewritten even when nothing was hidden, so dead windows leave it.
+    RecoveryStep StepBatch(size_t budget, BatchBackend& backend, const std::function<bool(uint64_t)>& canHide);
+
+    // Restore All: stages a restore into batch for every queued window that exists, empties
+    // the queue and commits. Queued windows have no tray icon, so if the batch itself writes
+    // nothing the state file is rewritten anyway.
+    BatchResult RestoreAll(WindowBatch& batch, BatchBackend& backend, const std::function<bool(uint64_t)>& exists);
+
+    bool Active() const { return m_cursor < m_windows.size(); }
+    size_t Total() const { return m_windows.size(); }
+    size_t Visited() const { return m_cursor; }
+    // Windows re-minimized by StepBatch since Begin
+    size_t Recovered() const { return m_recovered; }
+
+    // Not yet visited; still belongs in the state file
+    std::vector<uint64_t> Remaining() const;
+    // What the state file must hold: the currently hidden windows plus Remaining()
+    std::vector<uint64_t> WithRemaining(std::vector<uint64_t> hidden) const;
+
+private:
+    std::vector<uint64_t> m_windows;
+    size_t m_cursor = 0;
+    size_t m_recovered = 0;
+};
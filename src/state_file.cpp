@@ -0,0 +1,34 @@
+#include "state_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+std::string EncodeHiddenState(const std::vector<uint64_t>& windows) {
+    std::string bytes(windows.size() * sizeof(uint64_t), '\0');
+    if (!windows.empty()) std::memcpy(bytes.data(), windows.data(), bytes.size());
+    return bytes;
+}
+
+std::vector<uint64_t> DecodeHiddenState(std::string_view bytes) {
+    std::vector<uint64_t> windows(bytes.size() / sizeof(uint64_t));
+    if (!windows.empty()) std::memcpy(windows.data(), bytes.data(), windows.size() * sizeof(uint64_t));
+    return windows;
+}
+
+bool SaveHiddenState(const std::filesystem::path& file, const std::vector<uint64_t>& windows) {
+    std::ofstream outFile(file, std::ios::binary | std::ios::trunc);
+    if (!outFile) return false;
+
+    std::string bytes = EncodeHiddenState(windows);
+    outFile.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(outFile);
+}
+
+std::vector<uint64_t> LoadHiddenState(const std::filesystem::path& file) {
+    std::ifstream inFile(file, std::ios::binary);
+    if (!inFile) return {};
+
+    std::string bytes((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    return DecodeHiddenState(bytes);
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Crash-recovery state (traymond_recovery.dat): the handle of every hidden
+// window as a native-endian 64-bit integer (safe for x64), nothing else.
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+std::string EncodeHiddenState(const std::vector<uint64_t>& windows);
+
+// A truncated trailing record is ignored
+std::vector<uint64_t> DecodeHiddenState(std::string_view bytes);
+
+bool SaveHiddenState(const std::filesystem::path& file, const std::vector<uint64_t>& windows);
+
+// Empty if the file is missing or unreadable
+std::vector<uint64_t> LoadHiddenState(const std::filesystem::path& file);
@@ -0,0 +1,139 @@
+#include "thrash_guard.h"
+
+#include <algorithm>
+
+ThrashDecision ThrashGuard::OnHideAttempt(uint64_t window, uint32_t pid, Clock::time_point now) {
+    return Decide(window, pid, true, now);
+}
+
+ThrashDecision ThrashGuard::OnRetry(uint64_t window, uint32_t pid, Clock::time_point now) {
+    return Decide(window, pid, false, now);
+}
+
+ThrashDecision ThrashGuard::Decide(uint64_t window, uint32_t pid, bool mayStrike, Clock::time_point now) {
+    Budget& windowBudget = Touch(m_windows, window, m_policy.windowBurst, now);
+    Budget* processBudget = pid ? &Touch(m_processes, pid, m_policy.processBurst, now) : nullptr;
+
+    if (now < windowBudget.quarantinedUntil || (processBudget && now < processBudget->quarantinedUntil)) {
+        m_stats.suppressed++;
+        return ThrashDecision::Suppress;
+    }
+    if (now < windowBudget.blockedUntil || (processBudget && now < processBudget->blockedUntil)) {
+        m_stats.backoffs++;
+        return ThrashDecision::Backoff;
+    }
+
+    Refill(windowBudget, m_policy.windowBurst, m_policy.windowRefill, now);
+    if (processBudget) Refill(*processBudget, m_policy.processBurst, m_policy.processRefill, now);
+
+    if (windowBudget.tokens >= 1 && (!processBudget || processBudget->tokens >= 1)) {
+        windowBudget.tokens -= 1;
+        if (processBudget) processBudget->tokens -= 1;
+        windowBudget.allowed = true;
+        m_stats.allowed++;
+        return ThrashDecision::Allow;
+    }
+
+    // A first show waiting for its process's budget (many windows opening at once)
+    // and a retry are not thrashing: defer without a strike
+    if (!mayStrike || !windowBudget.allowed) {
+        m_stats.backoffs++;
+        return ThrashDecision::Backoff;
+    }
+
+    // A re-show: charge the strike to whichever budget ran out
+    return Strike(windowBudget.tokens < 1 ? windowBudget : *processBudget, now);
+}
+
+ThrashGuard::Clock::time_point ThrashGuard::RetryAt(uint64_t window, uint32_t pid) const {
+    Clock::time_point at{};
+    auto w = m_windows.find(window);
+    if (w != m_windows.end()) at = std::max(at, ReadyAt(w->second, m_policy.windowRefill));
+    auto p = m_processes.find(pid);
+    if (p != m_processes.end()) at = std::max(at, ReadyAt(p->second, m_policy.processRefill));
+    return at;
+}
+
+bool ThrashGuard::IsQuarantined(uint64_t window, uint32_t pid, Clock::time_point now) const {
+    auto w = m_windows.find(window);
+    if (w != m_windows.end() && now < w->second.quarantinedUntil) return true;
+    return IsProcessQuarantined(pid, now);
+}
+
+bool ThrashGuard::IsProcessQuarantined(uint32_t pid, Clock::time_point now) const {
+    auto p = m_processes.find(pid);
+    return p != m_processes.end() && now < p->second.quarantinedUntil;
+}
+
+size_t ThrashGuard::QuarantinedWindows(Clock::time_point now) const {
+    return std::count_if(m_windows.begin(), m_windows.end(),
+                         [now](const auto& entry) { return now < entry.second.quarantinedUntil; });
+}
+
+size_t ThrashGuard::QuarantinedProcesses(Clock::time_point now) const {
+    return std::count_if(m_processes.begin(), m_processes.end(),
+                         [now](const auto& entry) { return now < entry.second.quarantinedUntil; });
+}
+
+void ThrashGuard::Prune(Clock::time_point now) {
+    std::erase_if(m_windows, [&](const auto& entry) {
+        return IsIdle(entry.second, m_policy.windowBurst, m_policy.windowRefill, now);
+    });
+    std::erase_if(m_processes, [&](const auto& entry) {
+        return IsIdle(entry.second, m_policy.processBurst, m_policy.processRefill, now);
+    });
+}
+
+template <typename Key>
+ThrashGuard::Budget& ThrashGuard::Touch(std::unordered_map<Key, Budget>& budgets, Key key, double burst,
+                                        Clock::time_point now) {
+    auto [it, inserted] = budgets.try_emplace(key);
+    if (inserted) {
+        it->second.tokens = burst;
+        it->second.refilled = now;
+    }
+    return it->second;
+}
+
+void ThrashGuard::Refill(Budget& budget, double burst, ThrashPolicy::Duration interval, Clock::time_point now) {
+    if (now <= budget.refilled) return;
+    std::chrono::duration<double, std::milli> elapsed = now - budget.refilled;
+    budget.tokens = std::min(burst, budget.tokens + elapsed / interval);
+    budget.refilled = now;
+}
+
+ThrashGuard::Clock::time_point ThrashGuard::ReadyAt(const Budget& budget, ThrashPolicy::Duration interval) {
+    if (budget.tokens >= 1) return budget.blockedUntil;
+    // Rounded up so an attempt at exactly this time sees a whole token
+    std::chrono::duration<double, std::milli> missing = (1 - budget.tokens) * interval;
+    auto refilled = budget.refilled + std::chrono::ceil<std::chrono::milliseconds>(missing);
+    return std::max(budget.blockedUntil, refilled);
+}
+
+ThrashDecision ThrashGuard::Strike(Budget& budget, Clock::time_point now) {
+    if (budget.strikes > 0 && now - budget.lastStrike >= m_policy.strikeDecay) budget.strikes = 0;
+    budget.strikes++;
+    budget.lastStrike = now;
+
+    if (budget.strikes >= m_policy.maxStrikes) {
+        budget.strikes = 0;
+        budget.quarantinedUntil = now + m_policy.quarantine;
+        m_stats.quarantines++;
+        return ThrashDecision::Quarantine;
+    }
+
+    auto backoff = m_policy.initialBackoff;
+    for (uint32_t i = 1; i < budget.strikes && backoff < m_policy.maxBackoff; i++) backoff *= 2;
+    budget.blockedUntil = now + std::min(backoff, m_policy.maxBackoff);
+    m_stats.backoffs++;
+    return ThrashDecision::Backoff;
+}
+
+bool ThrashGuard::IsIdle(const Budget& budget, double burst, ThrashPolicy::Duration interval,
+                         Clock::time_point now) const {
+    if (now < budget.quarantinedUntil || now < budget.blockedUntil) return false;
+    if (budget.strikes > 0 && now - budget.lastStrike < m_policy.strikeDecay) return false;
+
+    std::chrono::duration<double, std::milli> elapsed = now - budget.refilled;
+    return budget.tokens + elapsed / interval >= burst;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+// Hysteresis for auto-minimize. Some programs immediately re-show a window
+// that was hidden, and hiding it again starts a loop of tray icon and state
+// file churn. Every auto-minimize attempt passes through a token bucket for
+// the window and one for its process. Attempts beyond the budget back off and
+// are retried once it refills. Only a window that shows again after it was
+// allowed earns a strike; strikes lengthen the backoff exponentially, and a
+// window or process that keeps striking is quarantined (left alone) for a
+// while. Time is passed in, so the policy runs on any clock.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+enum class ThrashDecision {
+    Allow,       // Hide the window
+    Backoff,     // Over budget: skip this attempt and retry at RetryAt
+    Quarantine,  // Limit exceeded just now: skip and notify the user once
+    Suppress,    // Already quarantined: skip silently
+};
+
+struct ThrashPolicy {
+    using Duration = std::chrono::milliseconds;
+
+    // Per window: hides allowed back to back, then one more per refill interval
+    double windowBurst = 3;
+    Duration windowRefill{ 2000 };
+    // Per process: catches programs that re-create the window instead of re-showing it
+    double processBurst = 10;
+    Duration processRefill{ 1000 };
+
+    // Backoff doubles with every strike, up to maxBackoff
+    Duration initialBackoff{ 500 };
+    Duration maxBackoff{ 30000 };
+    // Strikes before quarantine; a quiet strikeDecay period forgives them
+    uint32_t maxStrikes = 5;
+    Duration strikeDecay{ 60000 };
+    // Quarantine ends on its own so a reused window handle or pid is not penalized forever
+    Duration quarantine{ 10 * 60 * 1000 };
+};
+
+struct ThrashStats {
+    uint64_t allowed = 0;
+    uint64_t backoffs = 0;
+    uint64_t quarantines = 0;
+    uint64_t suppressed = 0;
+};
+
+class ThrashGuard {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ThrashGuard(ThrashPolicy policy = {}) : m_policy(policy) {}
+
+    // Decides whether an auto-minimize of window (owned by pid, 0 if unknown) may run now,
+    // after the window was shown
+    ThrashDecision OnHideAttempt(uint64_t window, uint32_t pid, Clock::time_point now = Clock::now());
+    // Same for a retry of a backed-off attempt; a retry never strikes
+    ThrashDecision OnRetry(uint64_t window, uint32_t pid, Clock::time_point now = Clock::now());
+
+    // Earliest time an attempt for window could be allowed, after a Backoff: the backoff
+    // has expired and both buckets hold a token again
+    Clock::time_point RetryAt(uint64_t window, uint32_t pid) const;
+
+    bool IsQuarantined(uint64_t window, uint32_t pid, Clock::time_point now = Clock::now()) const;
+    // True if the process as a whole is quarantined, not just one of its windows
+    bool IsProcessQuarantined(uint32_t pid, Clock::time_point now = Clock::now()) const;
+    // Currently quarantined windows and processes
+    size_t QuarantinedWindows(Clock::time_point now = Clock::now()) const;
+    size_t QuarantinedProcesses(Clock::time_point now = Clock::now()) const;
+
+    // Drops entries that are back to a full budget with no strikes or quarantine
+    void Prune(Clock::time_point now = Clock::now());
+    size_t TrackedCount() const { return m_windows.size() + m_processes.size(); }
+
+    const ThrashStats& Stats() const { return m_stats; }
+    const ThrashPolicy& Policy() const { return m_policy; }
+
+private:
+    struct Budget {
+        double tokens = 0;
+        Clock::time_point refilled;
+        Clock::time_point blockedUntil;
+        Clock::time_point lastStrike;
+        Clock::time_point quarantinedUntil;
+        uint32_t strikes = 0;
+        bool allowed = false;  // A window Traymond hid before; showing again is a re-show
+    };
+
+    ThrashDecision Decide(uint64_t window, uint32_t pid, bool mayStrike, Clock::time_point now);
+
+    template <typename Key>
+    Budget& Touch(std::unordered_map<Key, Budget>& budgets, Key key, double burst, Clock::time_point now);
+    static void Refill(Budget& budget, double burst, ThrashPolicy::Duration interval, Clock::time_point now);
+    static Clock::time_point ReadyAt(const Budget& budget, ThrashPolicy::Duration interval);
+    ThrashDecision Strike(Budget& budget, Clock::time_point now);
+    bool IsIdle(const Budget& budget, double burst, ThrashPolicy::Duration interval, Clock::time_point now) const;
+
+    ThrashPolicy m_policy;
+    std::unordered_map<uint64_t, Budget> m_windows;
+    std::unordered_map<uint32_t, Budget> m_processes;
+    ThrashStats m_stats;
+};
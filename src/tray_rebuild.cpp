@@ -0,0 +1,51 @@
+#include "tray_rebuild.h"
+
+void TrayRebuild::Begin(std::vector<uint64_t> icons, Clock::time_point now) {
+    m_pending.clear();
+    m_pending.reserve(icons.size());
+    for (uint64_t id : icons) {
+        m_pending.push_back({ id, 0 });
+    }
+    m_retry.clear();
+    m_cursor = 0;
+    m_started = now;
+    m_report = {};
+    m_active = true;
+}
+
+bool TrayRebuild::Step(const AddIcon& add, Clock::time_point now) {
+    if (!m_active) return true;
+    m_report.steps++;
+
+    for (size_t budget = m_burstSize; budget > 0; ) {
+        if (m_cursor == m_pending.size()) {
+            // Finished a pass: anything that failed goes around again
+            if (m_retry.empty()) break;
+            m_pending.swap(m_retry);
+            m_retry.clear();
+            m_cursor = 0;
+            // Give the shell until the next step before retrying
+            break;
+        }
+
+        Pending& p = m_pending[m_cursor++];
+        budget--;
+        TrayAddResult result = add(p.id);
+        if (result == TrayAddResult::Added) {
+            m_report.restored++;
+        } else if (result == TrayAddResult::Gone) {
+            m_report.gone++;
+        } else if (++p.attempts < m_maxAttempts) {
+            m_retry.push_back(p);
+        } else {
+            m_report.failed++;
+        }
+    }
+
+    if (m_cursor < m_pending.size() || !m_retry.empty()) return false;
+
+    m_active = false;
+    m_pending.clear();
+    m_report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_started);
+    return true;
+}
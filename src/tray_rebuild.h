@@ -0,0 +1,61 @@
+#pragma once
+
+// Paced re-registration of tray icons after Explorer restarts. The caller
+// supplies the add operation (Shell_NotifyIconW on Windows) and a timer that
+// calls Step() until it reports completion.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Outcome of one icon add. Gone: the window was restored or reaped meanwhile.
+enum class TrayAddResult {
+    Added,
+    Failed,
+    Gone,
+};
+
+struct TrayRebuildReport {
+    size_t restored = 0;
+    size_t failed = 0;
+    size_t gone = 0;
+    size_t steps = 0;
+    std::chrono::nanoseconds elapsed{ 0 };
+};
+
+class TrayRebuild {
+public:
+    using Clock = std::chrono::steady_clock;
+    using AddIcon = std::function<TrayAddResult(uint64_t)>;
+
+    // Icons added per Step() and attempts per icon before it is given up on
+    explicit TrayRebuild(size_t burstSize = 64, size_t maxAttempts = 5)
+        : m_burstSize(burstSize), m_maxAttempts(maxAttempts) {}
+
+    // Starts (or restarts, if the shell died again mid-rebuild) a rebuild
+    void Begin(std::vector<uint64_t> icons, Clock::time_point now = Clock::now());
+
+    // Adds the next burst; failed icons are retried on a later step.
+    // Returns true once the rebuild is finished and Report() is final.
+    bool Step(const AddIcon& add, Clock::time_point now = Clock::now());
+
+    bool Active() const { return m_active; }
+    const TrayRebuildReport& Report() const { return m_report; }
+
+private:
+    struct Pending {
+        uint64_t id;
+        size_t attempts;
+    };
+
+    size_t m_burstSize;
+    size_t m_maxAttempts;
+    bool m_active = false;
+    Clock::time_point m_started;
+    std::vector<Pending> m_pending;
+    std::vector<Pending> m_retry;
+    size_t m_cursor = 0;
+    TrayRebuildReport m_report;
+};
@@ -12,17 +12,35 @@
 #include <commdlg.h>
 #include <shlwapi.h>
 #include <psapi.h>
+#include <dwmapi.h>
 #include <vector>
 #include <string>
 #include <fstream>
+#include <iterator>
 #include <filesystem>
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <chrono>
+#include <unordered_map>
+
+#include "auto_rules.h"
+#include "config.h"
+#include "hidden_windows.h"
+#include "path_key.h"
+#include "phase_timer.h"
+#include "process_table.h"
+#include "recovery_queue.h"
+#include "state_file.h"
+#include "thrash_guard.h"
+#include "tray_rebuild.h"
+#include "window_batch.h"
+#include "window_reaper.h"
 
 #pragma comment(lib, "comctl32.lib")
 #pragma comment(lib, "shlwapi.lib")
 #pragma comment(lib, "psapi.lib")
+#pragma comment(lib, "dwmapi.lib")
 
 // Enable Visual Styles for modern Windows UI
 #pragma comment(linker,"\"/manifestdependency:type='win32' \
@@ -32,9 +50,21 @@ processorArchitecture='*' publicKeyToken='6595b64144ccf1df' language='*'\"")
 // Constants using modern constexpr
 constexpr UINT WM_TRAYICON = WM_APP + 1;
 constexpr UINT WM_AUTO_MINIMIZE = WM_APP + 2;
+constexpr UINT WM_PROCESS_EXITED = WM_APP + 3;  // wParam = pid, posted from the thread pool
+constexpr UINT WM_REAP_HIDDEN = WM_APP + 4;     // Flush dead hidden windows in one batch
+constexpr UINT WM_RECOVER_STEP = WM_APP + 5;    // Re-minimize the next chunk of a previous session's windows
+constexpr UINT WM_PRUNE_PROCESSES = WM_APP + 6; // Trim the process table outside the event hook
+constexpr size_t RECOVERY_CHUNK = 32;
+constexpr UINT_PTR TIMER_TRAY_REBUILD = 1;    // Paces icon re-registration after Explorer restarts
+constexpr UINT TRAY_REBUILD_INTERVAL_MS = 15;
+constexpr UINT_PTR TIMER_THRASH_RETRY = 2;    // Re-attempts auto-minimizes that were backed off
+constexpr size_t THRASH_PRUNE_AT = 256;       // Tracked windows + processes before idle ones are dropped
 constexpr UINT MENU_EXIT_ID = 1001;
 constexpr UINT MENU_RESTORE_ALL_ID = 1002;
 constexpr UINT MENU_SETTINGS_ID = 1003;
+constexpr UINT MENU_MINIMIZE_APP_ID = 1004;
+constexpr UINT MENU_MINIMIZE_MONITOR_ID = 1005;
+constexpr UINT MENU_AUTO_MINIMIZE_STATS_ID = 1006;
 constexpr wchar_t APP_CLASS_NAME[] = L"Traymond_Modern_Class";
 constexpr wchar_t APP_TITLE[] = L"Traymond";
 constexpr wchar_t MUTEX_NAME[] = L"Global\\Traymond_Single_Instance_Mutex";
@@ -48,19 +78,23 @@ constexpr wchar_t MUTEX_NAME[] = L"Global\\Traymond_Single_Instance_Mutex";
 #define IDC_BTN_REMOVE 1007
 #define IDC_HOTKEY_MINIMIZE 1008
 #define IDC_HOTKEY_AUTOADD 1009
+#define IDC_BTN_CHILDREN 1010
 
 // Data files
 const std::wstring DATA_FILENAME = L"traymond_recovery.dat";
 const std::wstring AUTO_MINIMIZE_FILE = L"traymond_auto.txt";
 const std::wstring HOTKEY_SETTINGS_FILE = L"traymond_hotkeys.txt";
-
-struct HiddenWindow {
-    HWND hWnd;
-    NOTIFYICONDATAW iconData;
-};
+const std::wstring STARTUP_TRACE_FILE = L"traymond_startup.log";
 
 // Global auto-minimize list
-std::vector<std::wstring> g_autoMinimizeList;
+AutoMinimizeRules g_autoMinimizeRules;
+
+// Processes seen by the event hook, with parent links for child-process rules.
+// Past PROCESS_TABLE_PRUNE_AT records, least recently used ones are evicted down to PROCESS_TABLE_KEEP.
+ProcessTable g_processTable;
+constexpr size_t PROCESS_TABLE_PRUNE_AT = 4096;
+constexpr size_t PROCESS_TABLE_KEEP = 3072;
+bool g_processPrunePosted = false;
 
 // Global ImageList for dialog icons
 HIMAGELIST g_hImageList = nullptr;
@@ -72,15 +106,13 @@ HWND g_hMainWnd = nullptr;
 // Set of windows being restored (to prevent immediate re-minimization)
 std::set<HWND> g_restoringWindows;
 
+// Hidden windows whose window or process may die while they sit in the tray
+WindowReaper g_windowReaper;
+
 // Track settings dialog state
 HWND g_hSettingsDlg = nullptr;
 
-// Hotkey configuration (modifier | virtualKey, 0 means disabled)
-struct HotkeyConfig {
-    UINT modifiers;
-    UINT vk;
-    bool enabled;
-};
+// Hotkey configuration
 HotkeyConfig g_hotkeyMinimize = { MOD_WIN | MOD_SHIFT, 'Z', true };  // Default: Win+Shift+Z
 HotkeyConfig g_hotkeyAutoAdd = { MOD_WIN | MOD_SHIFT, 'A', false };   // Default: disabled (to avoid conflicts)
 
@@ -118,50 +150,169 @@ bool IsStartupEnabled() {
     return exists;
 }
 
+// Win32 wide strings are UTF-16, the portable core uses char16_t
+static_assert(sizeof(wchar_t) == sizeof(char16_t), "Win32 wide strings are UTF-16");
+
+std::u16string_view AsU16(std::wstring_view s) {
+    return { reinterpret_cast<const char16_t*>(s.data()), s.size() };
+}
+
+const wchar_t* AsWide(const std::u16string& s) {
+    return reinterpret_cast<const wchar_t*>(s.c_str());
+}
+
 // Auto-minimize list management
 void LoadAutoList() {
-    std::wifstream infile(AUTO_MINIMIZE_FILE);
-    std::wstring line;
-    g_autoMinimizeList.clear();
-    while (std::getline(infile, line)) {
-        // Remove carriage return if present
-        line.erase(std::remove(line.begin(), line.end(), L'\r'), line.end());
-        if (!line.empty()) g_autoMinimizeList.push_back(line);
-    }
+    std::ifstream infile(AUTO_MINIMIZE_FILE, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(infile)), std::istreambuf_iterator<char>());
+    g_autoMinimizeRules.Assign(ParseAutoList(bytes));
 }
 
 void SaveAutoList() {
     std::wofstream outfile(AUTO_MINIMIZE_FILE);
-    for (const auto &name : g_autoMinimizeList) {
-        outfile << name << std::endl;
+    for (size_t i = 0; i < g_autoMinimizeRules.Size(); i++) {
+        AutoListEntry entry{ g_autoMinimizeRules.PathAt(i), g_autoMinimizeRules.IncludesChildren(i) };
+        outfile << AsWide(FormatAutoListLine(entry)) << std::endl;
     }
 }
 
 void LoadHotkeySettings() {
-    std::wifstream infile(HOTKEY_SETTINGS_FILE);
+    std::ifstream infile(HOTKEY_SETTINGS_FILE);
     if (!infile) return;
     
-    std::wstring line;
+    std::string line;
     // Line 1: Minimize hotkey
-    if (std::getline(infile, line)) {
-        int mods, vk, enabled;
-        if (swscanf_s(line.c_str(), L"%d,%d,%d", &mods, &vk, &enabled) == 3) {
-            g_hotkeyMinimize = { (UINT)mods, (UINT)vk, enabled != 0 };
-        }
-    }
+    if (std::getline(infile, line)) ParseHotkeyLine(line, g_hotkeyMinimize);
     // Line 2: Auto-add hotkey
-    if (std::getline(infile, line)) {
-        int mods, vk, enabled;
-        if (swscanf_s(line.c_str(), L"%d,%d,%d", &mods, &vk, &enabled) == 3) {
-            g_hotkeyAutoAdd = { (UINT)mods, (UINT)vk, enabled != 0 };
+    if (std::getline(infile, line)) ParseHotkeyLine(line, g_hotkeyAutoAdd);
+}
+
+void SaveHotkeySettings() {
+    std::ofstream outfile(HOTKEY_SETTINGS_FILE);
+    outfile << FormatHotkeyLine(g_hotkeyMinimize) << std::endl;
+    outfile << FormatHotkeyLine(g_hotkeyAutoAdd) << std::endl;
+}
+
+// Main application window test shared by auto-minimize and batch minimize
+bool IsMainAppWindow(HWND hwnd) {
+    // Only process visible windows with title bars (main application windows)
+    if (!IsWindowVisible(hwnd)) return false;
+    
+    // Check window styles - must be a main application window
+    LONG style = GetWindowLongW(hwnd, GWL_STYLE);
+    LONG exStyle = GetWindowLongW(hwnd, GWL_EXSTYLE);
+    
+    // Skip if not a main window (must have caption and be overlapped/popup style)
+    if (!(style & WS_CAPTION)) return false;
+    if (!(style & (WS_OVERLAPPEDWINDOW | WS_POPUP))) return false;
+    
+    // Skip tool windows, app bar windows, and other auxiliary windows
+    if (exStyle & WS_EX_TOOLWINDOW) return false;
+    if (exStyle & WS_EX_NOACTIVATE) return false;
+    
+    // Must have a window title
+    return GetWindowTextLengthW(hwnd) != 0;
+}
+
+// Process creation time, unique together with the pid
+uint64_t QueryStartTime(HANDLE hProcess) {
+    FILETIME creation, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(hProcess, &creation, &exitTime, &kernelTime, &userTime)) return 0;
+    return (uint64_t(creation.dwHighDateTime) << 32) | creation.dwLowDateTime;
+}
+
+// Parent pid from ProcessBasicInformation, one call instead of a Toolhelp snapshot
+DWORD QueryParentPid(HANDLE hProcess) {
+    using NtQueryInformationProcessFn = LONG (NTAPI*)(HANDLE, ULONG, PVOID, ULONG, PULONG);
+    static const auto query = reinterpret_cast<NtQueryInformationProcessFn>(
+        GetProcAddress(GetModuleHandleW(L"ntdll.dll"), "NtQueryInformationProcess"));
+    if (!query) return 0;
+
+    // PROCESS_BASIC_INFORMATION layout
+    struct {
+        LONG_PTR exitStatus;
+        PVOID pebBaseAddress;
+        ULONG_PTR affinityMask;
+        LONG_PTR basePriority;
+        ULONG_PTR uniqueProcessId;
+        ULONG_PTR inheritedFromUniqueProcessId;
+    } info = {};
+    if (query(hProcess, 0 /* ProcessBasicInformation */, &info, sizeof(info), nullptr) < 0) return 0;
+    return (DWORD)info.inheritedFromUniqueProcessId;
+}
+
+// Brings pid's record up to date. Path and parent are only queried for new or
+// reused pids. Returns false if the process can't be opened.
+bool RefreshProcess(DWORD pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) return false;
+
+    uint64_t startTime = QueryStartTime(hProcess);
+    const ProcessRecord* known = g_processTable.Find(pid);
+    if (known && known->startTime == startTime) {
+        g_processTable.Touch(pid);
+    } else {
+        ProcessRecord record;
+        record.parentPid = QueryParentPid(hProcess);
+        record.startTime = startTime;
+        wchar_t path[MAX_PATH];
+        DWORD size = MAX_PATH;
+        if (QueryFullProcessImageNameW(hProcess, 0, path, &size)) {
+            record.image = MakePathKey(AsU16({ path, size }));
+        }
+        g_processTable.Upsert(pid, std::move(record));
+
+        // Evict from the message loop, once per overflow, never inside the hook
+        if (g_processTable.Size() > PROCESS_TABLE_PRUNE_AT && !g_processPrunePosted) {
+            g_processPrunePosted = PostMessageW(g_hMainWnd, WM_PRUNE_PROCESSES, 0, 0) != FALSE;
         }
     }
+    CloseHandle(hProcess);
+    return true;
 }
 
-void SaveHotkeySettings() {
-    std::wofstream outfile(HOTKEY_SETTINGS_FILE);
-    outfile << g_hotkeyMinimize.modifiers << L"," << g_hotkeyMinimize.vk << L"," << (g_hotkeyMinimize.enabled ? 1 : 0) << std::endl;
-    outfile << g_hotkeyAutoAdd.modifiers << L"," << g_hotkeyAutoAdd.vk << L"," << (g_hotkeyAutoAdd.enabled ? 1 : 0) << std::endl;
+// Walks pid's parent chain, refreshing each ancestor. Records of exited
+// ancestors are kept and marked used (launchers often exit right after
+// starting the app); the start-time check in ProcessTable rejects them once
+// their pid is reused.
+void RefreshAncestors(DWORD pid) {
+    for (size_t depth = 0; depth < ProcessTable::kMaxDepth; depth++) {
+        const ProcessRecord* record = g_processTable.Find(pid);
+        if (!record || record->parentPid == 0 || record->parentPid == pid) return;
+
+        DWORD parentPid = record->parentPid;
+        if (!RefreshProcess(parentPid) && !g_processTable.Touch(parentPid)) return;
+        pid = parentPid;
+    }
+}
+
+// File name of pid's executable ("app.exe"), empty if it cannot be queried
+std::wstring QueryProcessName(DWORD pid) {
+    HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (!hProcess) return {};
+    wchar_t path[MAX_PATH];
+    DWORD size = MAX_PATH;
+    bool ok = QueryFullProcessImageNameW(hProcess, 0, path, &size) != FALSE;
+    CloseHandle(hProcess);
+    return ok ? std::wstring(PathFindFileNameW(path)) : std::wstring();
+}
+
+// True if hwnd is a shown main window that the auto-minimize list asks for. Checked for
+// every show event and again before a backed-off retry, as rules and windows change.
+bool ShouldAutoMinimize(HWND hwnd) {
+    // Skip if window is being restored by user
+    if (g_restoringWindows.count(hwnd) > 0) return false;
+
+    if (!IsMainAppWindow(hwnd)) return false;
+
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+
+    if (g_autoMinimizeRules.Empty() || !RefreshProcess(pid)) return false;
+    if (g_autoMinimizeRules.HasTreeRules()) RefreshAncestors(pid);
+
+    // Check the process (or, for child-process rules, its ancestors) against our auto-minimize list
+    return g_autoMinimizeRules.MatchesProcess(g_processTable, pid);
 }
 
 // Event hook callback to detect new windows and auto-minimize them
@@ -172,49 +323,19 @@ void CALLBACK WinEventProc(HWINEVENTHOOK hWinEventHook, DWORD event, HWND hwnd,
     UNREFERENCED_PARAMETER(dwEventThread);
     UNREFERENCED_PARAMETER(dwmsEventTime);
     
+    // A hidden window was destroyed: queue it for reaping, flushing once per batch
+    if (event == EVENT_OBJECT_DESTROY && idObject == OBJID_WINDOW && idChild == CHILDID_SELF) {
+        if (g_windowReaper.OnWindowDestroyed(reinterpret_cast<uint64_t>(hwnd))) {
+            PostMessageW(g_hMainWnd, WM_REAP_HIDDEN, 0, 0);
+        }
+        return;
+    }
+
     // Only interested in main windows being shown
     if (event == EVENT_OBJECT_SHOW && idObject == OBJID_WINDOW && idChild == CHILDID_SELF) {
-        // Skip if window is being restored by user
-        if (g_restoringWindows.count(hwnd) > 0) return;
-        
-        // Only process visible windows with title bars (main application windows)
-        if (!IsWindowVisible(hwnd)) return;
-        
-        // Check window styles - must be a main application window
-        LONG style = GetWindowLongW(hwnd, GWL_STYLE);
-        LONG exStyle = GetWindowLongW(hwnd, GWL_EXSTYLE);
-        
-        // Skip if not a main window (must have caption and be overlapped/popup style)
-        if (!(style & WS_CAPTION)) return;
-        if (!(style & (WS_OVERLAPPEDWINDOW | WS_POPUP))) return;
-        
-        // Skip tool windows, app bar windows, and other auxiliary windows
-        if (exStyle & WS_EX_TOOLWINDOW) return;
-        if (exStyle & WS_EX_NOACTIVATE) return;
-        
-        // Must have a window title
-        if (GetWindowTextLengthW(hwnd) == 0) return;
-
-        DWORD pid = 0;
-        GetWindowThreadProcessId(hwnd, &pid);
-        
-        HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
-        if (hProcess) {
-            wchar_t processPath[MAX_PATH];
-            if (GetModuleFileNameExW(hProcess, NULL, processPath, MAX_PATH)) {
-                std::wstring fullPath = processPath;
-                
-                // Check if path exists in our auto-minimize list
-                for (const auto& target : g_autoMinimizeList) {
-                    // Case-insensitive comparison
-                    if (_wcsicmp(fullPath.c_str(), target.c_str()) == 0) {
-                        // Found a match! Send message to main window to minimize it safely
-                        PostMessageW(g_hMainWnd, WM_AUTO_MINIMIZE, (WPARAM)hwnd, 0);
-                        break;
-                    }
-                }
-            }
-            CloseHandle(hProcess);
+        if (ShouldAutoMinimize(hwnd)) {
+            // Found a match! Send message to main window to minimize it safely
+            PostMessageW(g_hMainWnd, WM_AUTO_MINIMIZE, (WPARAM)hwnd, 0);
         }
     }
 }
@@ -230,10 +351,12 @@ void RefreshAppList(HWND hDlg) {
     ListView_SetImageList(hList, g_hImageList, LVSIL_SMALL);
 
     int index = 0;
-    for (const auto& path : g_autoMinimizeList) {
+    for (const auto& path : g_autoMinimizeRules.Paths()) {
+        bool includeChildren = g_autoMinimizeRules.IncludesChildren(index);
+
         // Extract icon from file
         SHFILEINFOW sfi = { 0 };
-        SHGetFileInfoW(path.c_str(), 0, &sfi, sizeof(sfi), SHGFI_ICON | SHGFI_SMALLICON);
+        SHGetFileInfoW(AsWide(path), 0, &sfi, sizeof(sfi), SHGFI_ICON | SHGFI_SMALLICON);
         
         int iconIndex = -1;
         if (sfi.hIcon) {
@@ -246,8 +369,9 @@ void RefreshAppList(HWND hDlg) {
         lvi.mask = LVIF_TEXT | LVIF_IMAGE;
         lvi.iItem = index++;
         lvi.iImage = iconIndex;
-        lvi.pszText = const_cast<LPWSTR>(path.c_str());
+        lvi.pszText = const_cast<LPWSTR>(AsWide(path));
         ListView_InsertItem(hList, &lvi);
+        ListView_SetItemText(hList, lvi.iItem, 1, const_cast<LPWSTR>(includeChildren ? L"Yes" : L""));
     }
 }
 
@@ -270,6 +394,9 @@ INT_PTR CALLBACK SettingsDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
             lvc.cx = 300;
             lvc.pszText = (LPWSTR)L"Application Path";
             ListView_InsertColumn(hList, 0, &lvc);
+            lvc.cx = 80;
+            lvc.pszText = (LPWSTR)L"Child Processes";
+            ListView_InsertColumn(hList, 1, &lvc);
             
             // Set extended style for full row select
             ListView_SetExtendedListViewStyle(hList, LVS_EX_FULLROWSELECT);
@@ -316,14 +443,7 @@ INT_PTR CALLBACK SettingsDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
             
             if (GetOpenFileNameW(&ofn)) {
                 // Check if already exists
-                bool exists = false;
-                std::wstring newPath = filename;
-                for(const auto& s : g_autoMinimizeList) {
-                    if(s == newPath) { exists = true; break; }
-                }
-                
-                if(!exists) {
-                    g_autoMinimizeList.push_back(newPath);
+                if (g_autoMinimizeRules.Add(std::u16string(AsU16(filename)))) {
                     RefreshAppList(hDlg);
                 }
             }
@@ -332,11 +452,21 @@ INT_PTR CALLBACK SettingsDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
             // Remove selected item
             HWND hList = GetDlgItem(hDlg, IDC_LIST_APPS);
             int selected = ListView_GetNextItem(hList, -1, LVNI_SELECTED);
-            if (selected != -1 && selected < (int)g_autoMinimizeList.size()) {
-                g_autoMinimizeList.erase(g_autoMinimizeList.begin() + selected);
+            if (selected != -1 && selected < (int)g_autoMinimizeRules.Size()) {
+                g_autoMinimizeRules.RemoveAt(selected);
                 RefreshAppList(hDlg);
             }
         }
+        else if (LOWORD(wParam) == IDC_BTN_CHILDREN) {
+            // Toggle matching of the selected item's child processes
+            HWND hList = GetDlgItem(hDlg, IDC_LIST_APPS);
+            int selected = ListView_GetNextItem(hList, -1, LVNI_SELECTED);
+            if (selected != -1 && selected < (int)g_autoMinimizeRules.Size()) {
+                g_autoMinimizeRules.SetIncludeChildren(selected, !g_autoMinimizeRules.IncludesChildren(selected));
+                RefreshAppList(hDlg);
+                ListView_SetItemState(hList, selected, LVIS_SELECTED, LVIS_SELECTED);
+            }
+        }
         else if (LOWORD(wParam) == IDOK) {
             // Save startup setting
             SetStartup(IsDlgButtonChecked(hDlg, IDC_CHK_STARTUP) == BST_CHECKED);
@@ -426,9 +556,10 @@ INT_PTR CALLBACK SettingsDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
     return (INT_PTR)FALSE;
 }
 
-class TraymondApp {
+class TraymondApp : private BatchBackend {
 public:
-    TraymondApp(HINSTANCE hInstance) : m_hInstance(hInstance), m_mainWindow(nullptr), m_trayMenu(nullptr) {}
+    TraymondApp(HINSTANCE hInstance, bool traceStartup)
+        : m_hInstance(hInstance), m_mainWindow(nullptr), m_trayMenu(nullptr), m_startupTrace(traceStartup) {}
 
     ~TraymondApp() {
         // Unhook the window event monitoring
@@ -438,6 +569,12 @@ public:
         }
         
         RestoreAllWindows();
+        for (auto& [pid, wait] : m_processWaits) {
+            UnregisterWaitEx(wait.hWait, INVALID_HANDLE_VALUE);
+            CloseHandle(wait.hProcess);
+        }
+        m_processWaits.clear();
+
         if (m_mainWindow) {
             UnregisterHotKey(m_mainWindow, 1);
             UnregisterHotKey(m_mainWindow, 2);
@@ -448,12 +585,14 @@ public:
 
     bool Initialize() {
         // Prevent multiple instances
+        m_startupTrace.Begin("mutex");
         m_hMutex.reset(CreateMutexW(nullptr, TRUE, MUTEX_NAME));
         if (GetLastError() == ERROR_ALREADY_EXISTS) {
             MessageBoxW(nullptr, L"Traymond is already running.", APP_TITLE, MB_ICONERROR);
             return false;
         }
 
+        m_startupTrace.Begin("window_class");
         WNDCLASSEXW wc = { 0 };
         wc.cbSize = sizeof(WNDCLASSEXW);
         wc.lpfnWndProc = WindowProc;
@@ -462,16 +601,23 @@ public:
 
         if (!RegisterClassExW(&wc)) return false;
 
-        // Create a message-only window
-        m_mainWindow = CreateWindowExW(0, APP_CLASS_NAME, APP_TITLE, 0, 0, 0, 0, 0, HWND_MESSAGE, nullptr, m_hInstance, this);
+        // Create a hidden top-level window (message-only windows miss the TaskbarCreated broadcast)
+        m_startupTrace.Begin("main_window");
+        m_mainWindow = CreateWindowExW(WS_EX_TOOLWINDOW, APP_CLASS_NAME, APP_TITLE, WS_POPUP, 0, 0, 0, 0, nullptr, nullptr, m_hInstance, this);
         if (!m_mainWindow) return false;
 
+        // Explorer broadcasts this after it (re)creates the taskbar; allow it through UIPI when elevated
+        m_taskbarCreatedMsg = RegisterWindowMessageW(L"TaskbarCreated");
+        if (m_taskbarCreatedMsg) ChangeWindowMessageFilterEx(m_mainWindow, m_taskbarCreatedMsg, MSGFLT_ALLOW, nullptr);
+
         // Store main window handle globally for WinEventProc callback
         g_hMainWnd = m_mainWindow;
 
         // Register WinEventHook to monitor new windows for auto-minimize
+        // and destroyed windows for reaping (EVENT_OBJECT_DESTROY precedes EVENT_OBJECT_SHOW)
+        m_startupTrace.Begin("event_hook");
         g_hEventHook = SetWinEventHook(
-            EVENT_OBJECT_SHOW, EVENT_OBJECT_SHOW,
+            EVENT_OBJECT_DESTROY, EVENT_OBJECT_SHOW,
             nullptr,
             WinEventProc,
             0, 0,
@@ -479,6 +625,7 @@ public:
         );
 
         // Load hotkey settings
+        m_startupTrace.Begin("hotkeys");
         LoadHotkeySettings();
         
         // Register hotkeys with graceful error handling
@@ -496,15 +643,26 @@ public:
             }
         }
 
+        m_startupTrace.Begin("tray_icon");
         CreateTrayIcon();
         CreateTrayMenu();
-        LoadState(); // Recovery from crash
+        m_startupTrace.Begin("auto_list");
         LoadAutoList(); // Load auto-minimize settings
+        m_startupTrace.Begin("recovery_read");
+        LoadState(); // Recovery from crash, continued from the message loop
+        m_startupTrace.End();
 
         return true;
     }
 
     void Run() {
+        // Crash recovery runs in chunks once hotkeys and the tray are already live
+        if (m_recovery.Active()) {
+            PostMessageW(m_mainWindow, WM_RECOVER_STEP, 0, 0);
+        } else {
+            WriteStartupTrace();
+        }
+
         MSG msg;
         while (GetMessageW(&msg, nullptr, 0, 0)) {
             TranslateMessage(&msg);
@@ -516,8 +674,31 @@ private:
     HINSTANCE m_hInstance;
     HWND m_mainWindow;
     HMENU m_trayMenu;
-    std::vector<HiddenWindow> m_hiddenWindows;
+    HiddenWindowTable<NOTIFYICONDATAW> m_hiddenWindows; // Tray icon data per hidden window
+
+    // Targets captured when the tray menu opens (before Traymond takes the foreground)
+    HWND m_menuTargetWindow = nullptr;
+    HMONITOR m_menuTargetMonitor = nullptr;
+
+    // Tray icon re-registration after Explorer restarts
+    UINT m_taskbarCreatedMsg = 0;
+    TrayRebuild m_trayRebuild;
+
+    // Thread-pool waits on processes that own hidden windows (one per process)
+    struct ProcessWait {
+        HANDLE hProcess;
+        HANDLE hWait;
+    };
+    std::unordered_map<DWORD, ProcessWait> m_processWaits;
     
+    // Startup profiling (--trace-startup) and incremental crash recovery
+    PhaseTimer m_startupTrace;
+    RecoveryQueue m_recovery;
+
+    // Rate limit for auto-minimize against programs that keep re-showing their windows
+    ThrashGuard m_thrashGuard;
+    std::unordered_map<HWND, ThrashGuard::Clock::time_point> m_thrashRetries; // Backed-off windows and when to retry
+
     // RAII wrapper for Handle
     struct HandleDeleter { void operator()(HANDLE h) { if (h) CloseHandle(h); } };
     std::unique_ptr<void, HandleDeleter> m_hMutex;
@@ -537,6 +718,12 @@ private:
     }
 
     LRESULT HandleMessage(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+        // Registered message, so it cannot be a case label
+        if (m_taskbarCreatedMsg != 0 && uMsg == m_taskbarCreatedMsg) {
+            BeginTrayRebuild();
+            return 0;
+        }
+
         switch (uMsg) {
         case WM_TRAYICON:
             // CRITICAL FIX: wParam contains the icon ID, not lParam
@@ -558,6 +745,8 @@ private:
                     // Right-click shows main menu
                     POINT pt;
                     GetCursorPos(&pt);
+                    m_menuTargetWindow = FindTopmostAppWindow();
+                    m_menuTargetMonitor = MonitorFromPoint(pt, MONITOR_DEFAULTTONEAREST);
                     SetForegroundWindow(hwnd);
                     TrackPopupMenu(m_trayMenu, TPM_BOTTOMALIGN | TPM_RIGHTALIGN, pt.x, pt.y, 0, hwnd, nullptr);
                 }
@@ -586,12 +775,45 @@ private:
 
         case WM_AUTO_MINIMIZE:
             // Sent by WinEventProc when a window from the auto-minimize list is detected
-            MinimizeWindow((HWND)wParam);
+            AutoMinimizeWindow((HWND)wParam);
+            break;
+
+        case WM_PROCESS_EXITED:
+            {
+                // Ignore late notifications for waits that were already released
+                auto it = m_processWaits.find((DWORD)wParam);
+                if (it != m_processWaits.end() && WaitForSingleObject(it->second.hProcess, 0) == WAIT_OBJECT_0) {
+                    if (g_windowReaper.OnProcessExited((DWORD)wParam)) {
+                        PostMessageW(m_mainWindow, WM_REAP_HIDDEN, 0, 0);
+                    }
+                }
+            }
+            break;
+
+        case WM_REAP_HIDDEN:
+            ReapDeadWindows();
+            break;
+
+        case WM_RECOVER_STEP:
+            StepRecovery();
+            break;
+
+        case WM_PRUNE_PROCESSES:
+            g_processTable.EvictLeastRecentlyUsed(PROCESS_TABLE_KEEP);
+            g_processPrunePosted = false;
+            break;
+
+        case WM_TIMER:
+            if (wParam == TIMER_TRAY_REBUILD) StepTrayRebuild();
+            else if (wParam == TIMER_THRASH_RETRY) RetryBackedOffWindows();
             break;
 
         case WM_COMMAND:
             switch (LOWORD(wParam)) {
             case MENU_RESTORE_ALL_ID: RestoreAllWindows(); break;
+            case MENU_MINIMIZE_APP_ID: MinimizeAppWindows(m_menuTargetWindow); break;
+            case MENU_MINIMIZE_MONITOR_ID: MinimizeMonitorWindows(m_menuTargetMonitor); break;
+            case MENU_AUTO_MINIMIZE_STATS_ID: ShowAutoMinimizeStats(); break;
             case MENU_SETTINGS_ID: 
                 // Check if dialog is already open
                 if (g_hSettingsDlg && IsWindow(g_hSettingsDlg)) {
@@ -615,39 +837,185 @@ private:
         return DefWindowProcW(hwnd, uMsg, wParam, lParam);
     }
 
+    // Validation: Don't minimize self or desktop/taskbar
+    bool CanMinimize(HWND hTarget) {
+        if (!hTarget || !IsWindow(hTarget)) return false;
+        if (hTarget == m_mainWindow) return false;
+        return hTarget != GetDesktopWindow() && hTarget != FindWindowW(L"Shell_TrayWnd", nullptr);
+    }
+
     // Core minimize logic - can be called for any window
     void MinimizeWindow(HWND hTarget) {
-        if (!hTarget || !IsWindow(hTarget)) return;
+        if (!CanMinimize(hTarget)) return;
 
-        // Validation: Don't minimize self or desktop/taskbar
-        if (hTarget == GetDesktopWindow() || hTarget == FindWindowW(L"Shell_TrayWnd", nullptr)) return;
-        
-        // Check if already hidden
-        for (const auto& hw : m_hiddenWindows) {
-            if (hw.hWnd == hTarget) return; 
+        WindowBatch batch;
+        batch.Hide(reinterpret_cast<uint64_t>(hTarget));
+        batch.Commit(*this);
+    }
+
+    // Auto-minimize goes through the thrash guard; hotkeys and menu actions do not.
+    // retry is set for a backed-off attempt coming back, which never counts as a re-show.
+    void AutoMinimizeWindow(HWND hTarget, bool retry = false) {
+        if (!CanMinimize(hTarget)) return;
+
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hTarget, &pid);
+        if (m_thrashGuard.TrackedCount() > THRASH_PRUNE_AT) m_thrashGuard.Prune();
+
+        uint64_t window = reinterpret_cast<uint64_t>(hTarget);
+        ThrashDecision decision = retry ? m_thrashGuard.OnRetry(window, pid) : m_thrashGuard.OnHideAttempt(window, pid);
+        switch (decision) {
+        case ThrashDecision::Allow:
+            if (m_hiddenWindows.Contains(reinterpret_cast<uint64_t>(hTarget))) {
+                // Showed itself while hidden: its tray icon and the state file are still current
+                WindowBatch batch;
+                batch.Rehide(reinterpret_cast<uint64_t>(hTarget));
+                batch.Commit(*this);
+            } else {
+                MinimizeWindow(hTarget);
+            }
+            break;
+        case ThrashDecision::Quarantine:
+            {
+                // Give up on the window for now; drop its tray icon if it re-showed itself while hidden
+                if (m_hiddenWindows.Contains(reinterpret_cast<uint64_t>(hTarget))) {
+                    WindowBatch batch;
+                    batch.Forget(reinterpret_cast<uint64_t>(hTarget));
+                    batch.Commit(*this);
+                }
+
+                auto minutes = std::to_wstring(
+                    std::chrono::duration_cast<std::chrono::minutes>(m_thrashGuard.Policy().quarantine).count());
+                std::wstring msg;
+                if (m_thrashGuard.IsProcessQuarantined(pid)) {
+                    // Its windows took turns re-showing: the whole program is paused
+                    std::wstring program = QueryProcessName(pid);
+                    if (program.empty()) program = L"A program";
+                    msg = program + L" keeps re-showing its windows. Auto-minimize is paused for this program for " +
+                          minutes + L" minutes.";
+                } else {
+                    wchar_t title[128] = { 0 };
+                    GetWindowTextW(hTarget, title, static_cast<int>(std::size(title)));
+                    msg = std::wstring(title) + L" keeps re-showing itself. Auto-minimize is paused for it for " +
+                          minutes + L" minutes.";
+                }
+                ShowBalloonTip(L"Auto-Minimize Paused", msg.c_str());
+            }
+            break;
+        case ThrashDecision::Backoff:
+            // Try again once the budget allows it, so a window's first show is not lost
+            m_thrashRetries[hTarget] = m_thrashGuard.RetryAt(reinterpret_cast<uint64_t>(hTarget), pid);
+            ArmThrashRetryTimer();
+            break;
+        case ThrashDecision::Suppress:
+            break;
         }
+    }
 
-        // Get Icon
-        HICON hIcon = (HICON)SendMessageW(hTarget, WM_GETICON, ICON_SMALL, 0);
-        if (!hIcon) hIcon = (HICON)GetClassLongPtrW(hTarget, GCLP_HICONSM);
-        if (!hIcon) hIcon = LoadIconW(nullptr, IDI_APPLICATION); // Fallback
+    void ArmThrashRetryTimer() {
+        if (m_thrashRetries.empty()) {
+            KillTimer(m_mainWindow, TIMER_THRASH_RETRY);
+            return;
+        }
+        auto next = std::min_element(m_thrashRetries.begin(), m_thrashRetries.end(),
+                                     [](const auto& a, const auto& b) { return a.second < b.second; })->second;
+        auto delay = std::chrono::ceil<std::chrono::milliseconds>(next - ThrashGuard::Clock::now()).count();
+        SetTimer(m_mainWindow, TIMER_THRASH_RETRY,
+                 static_cast<UINT>(std::clamp<long long>(delay, USER_TIMER_MINIMUM, USER_TIMER_MAXIMUM)), nullptr);
+    }
 
-        // Setup Tray Icon
-        NOTIFYICONDATAW nid = { sizeof(NOTIFYICONDATAW) };
-        nid.hWnd = m_mainWindow;
-        nid.uID = static_cast<UINT>(reinterpret_cast<UINT_PTR>(hTarget)); // Unique ID based on HWND
-        nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
-        nid.uCallbackMessage = WM_TRAYICON;
-        nid.hIcon = hIcon;
-        
-        // Get Window Title for Tooltip
-        GetWindowTextW(hTarget, nid.szTip, 128);
+    void RetryBackedOffWindows() {
+        auto now = ThrashGuard::Clock::now();
+        std::vector<HWND> due;
+        std::erase_if(m_thrashRetries, [&](const auto& entry) {
+            if (now < entry.second) return false;
+            due.push_back(entry.first);
+            return true;
+        });
+        for (HWND hTarget : due) {
+            // Drop windows that closed, went away on their own, are being restored by the
+            // user or no longer match a rule
+            if (ShouldAutoMinimize(hTarget)) AutoMinimizeWindow(hTarget, true);
+        }
+        ArmThrashRetryTimer();
+    }
+
+    void ShowAutoMinimizeStats() {
+        const ThrashStats& stats = m_thrashGuard.Stats();
+        std::wstring msg = L"Hidden: " + std::to_wstring(stats.allowed) +
+                           L"\nBacked off: " + std::to_wstring(stats.backoffs) +
+                           L"\nQuarantined: " + std::to_wstring(stats.quarantines) +
+                           L" (now " + std::to_wstring(m_thrashGuard.QuarantinedWindows()) + L" windows, " +
+                           std::to_wstring(m_thrashGuard.QuarantinedProcesses()) + L" programs)" +
+                           L"\nIgnored while quarantined: " + std::to_wstring(stats.suppressed);
+        ShowBalloonTip(L"Auto-Minimize Statistics", msg.c_str());
+    }
 
-        if (Shell_NotifyIconW(NIM_ADD, &nid)) {
-            ShowWindow(hTarget, SW_HIDE);
-            m_hiddenWindows.push_back({ hTarget, nid });
-            SaveState();
+    // Batch minimize: every main window of the process that owns hReference
+    void MinimizeAppWindows(HWND hReference) {
+        if (!CanMinimize(hReference)) return;
+
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hReference, &pid);
+        if (pid == 0) return;
+
+        MinimizeMatchingWindows([pid](HWND hwnd) {
+            DWORD windowPid = 0;
+            GetWindowThreadProcessId(hwnd, &windowPid);
+            return windowPid == pid;
+        });
+    }
+
+    // Batch minimize: every main window shown on the given monitor
+    void MinimizeMonitorWindows(HMONITOR hMonitor) {
+        if (!hMonitor) return;
+
+        MinimizeMatchingWindows([hMonitor](HWND hwnd) {
+            return MonitorFromWindow(hwnd, MONITOR_DEFAULTTONULL) == hMonitor;
+        });
+    }
+
+    template <typename Predicate>
+    void MinimizeMatchingWindows(Predicate matches) {
+        std::vector<HWND> windows;
+        EnumWindows([](HWND hwnd, LPARAM lParam) -> BOOL {
+            reinterpret_cast<std::vector<HWND>*>(lParam)->push_back(hwnd);
+            return TRUE;
+        }, reinterpret_cast<LPARAM>(&windows));
+
+        WindowBatch batch;
+        for (HWND hwnd : windows) {
+            if (IsOnScreenAppWindow(hwnd) && matches(hwnd)) {
+                batch.Hide(reinterpret_cast<uint64_t>(hwnd));
+            }
+        }
+        batch.Commit(*this);
+    }
+
+    // The window the user was working in, even if the taskbar currently has focus
+    HWND FindTopmostAppWindow() {
+        HWND hForeground = GetForegroundWindow();
+        if (hForeground && IsOnScreenAppWindow(hForeground)) return hForeground;
+
+        for (HWND hwnd = GetTopWindow(nullptr); hwnd; hwnd = GetWindow(hwnd, GW_HWNDNEXT)) {
+            if (IsOnScreenAppWindow(hwnd)) return hwnd;
         }
+        return nullptr;
+    }
+
+    // Batch candidates: main windows of other programs the user can actually see.
+    // Cloaked windows (other virtual desktops, suspended UWP frames) still pass
+    // IsWindowVisible, and our own settings dialog is not ours to hide.
+    bool IsOnScreenAppWindow(HWND hwnd) {
+        if (!IsMainAppWindow(hwnd) || !CanMinimize(hwnd)) return false;
+
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hwnd, &pid);
+        if (pid == GetCurrentProcessId()) return false;
+
+        DWORD cloaked = 0;
+        if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked) return false;
+        return true;
     }
 
     // Wrapper for hotkey - minimizes the currently focused window
@@ -684,19 +1052,9 @@ private:
 
         std::wstring procPath = processPath;
 
-        // Check if already exists
-        bool exists = false;
-        for (const auto& s : g_autoMinimizeList) {
-            if (_wcsicmp(s.c_str(), procPath.c_str()) == 0) {
-                exists = true;
-                break;
-            }
-        }
-
-        if (exists) {
+        if (!g_autoMinimizeRules.Add(std::u16string(AsU16(procPath)))) {
             ShowBalloonTip(L"Info", L"Application is already in auto-minimize list.");
         } else {
-            g_autoMinimizeList.push_back(procPath);
             SaveAutoList();
             
             // Refresh dialog if open
@@ -723,20 +1081,19 @@ private:
     }
 
     void RestoreWindowById(UINT uID) {
-        auto it = std::find_if(m_hiddenWindows.begin(), m_hiddenWindows.end(), 
-            [uID](const HiddenWindow& hw) { return hw.iconData.uID == uID; });
+        // Tray IDs are the low 32 bits of the HWND; handles are sign-extended on x64
+        HWND hwnd = static_cast<HWND>(LongToHandle(static_cast<LONG>(uID)));
 
-        if (it != m_hiddenWindows.end()) {
-            HWND hwnd = it->hWnd;
+        if (m_hiddenWindows.Contains(reinterpret_cast<uint64_t>(hwnd))) {
             
             // Add to restoring set to prevent immediate re-minimization
             g_restoringWindows.insert(hwnd);
+            m_thrashRetries.erase(hwnd);
             
-            ShowWindow(hwnd, SW_SHOW);
+            WindowBatch batch;
+            batch.Restore(reinterpret_cast<uint64_t>(hwnd));
+            batch.Commit(*this);
             SetForegroundWindow(hwnd);
-            Shell_NotifyIconW(NIM_DELETE, &it->iconData);
-            m_hiddenWindows.erase(it);
-            SaveState();
             
             // Remove from restoring set after 500ms delay
             SetTimer(m_mainWindow, (UINT_PTR)hwnd, 500, [](HWND, UINT, UINT_PTR idEvent, DWORD) {
@@ -746,14 +1103,19 @@ private:
     }
 
     void RestoreAllWindows() {
-        for (auto& hw : m_hiddenWindows) {
+        WindowBatch batch;
+        for (const auto& hw : m_hiddenWindows) {
             // Add to restoring set to prevent immediate re-minimization
-            g_restoringWindows.insert(hw.hWnd);
-            ShowWindow(hw.hWnd, SW_SHOW);
-            Shell_NotifyIconW(NIM_DELETE, &hw.iconData);
+            g_restoringWindows.insert(reinterpret_cast<HWND>(hw.window));
+            batch.Restore(hw.window);
         }
-        m_hiddenWindows.clear();
-        SaveState();
+        // The user wants everything back: pending auto-minimize retries are dropped too
+        m_thrashRetries.clear();
+        ArmThrashRetryTimer();
+        // Windows of a previous session that recovery has not reached yet are still hidden
+        m_recovery.RestoreAll(batch, *this, [](uint64_t handleVal) {
+            return IsWindow(reinterpret_cast<HWND>(handleVal)) != FALSE;
+        });
         
         // Clear restoring set after 500ms delay
         SetTimer(m_mainWindow, 9999, 500, [](HWND, UINT, UINT_PTR, DWORD) {
@@ -761,6 +1123,177 @@ private:
         });
     }
 
+    // --- Reaping of dead hidden windows ---
+    static VOID CALLBACK ProcessExitCallback(PVOID context, BOOLEAN timedOut) {
+        UNREFERENCED_PARAMETER(timedOut);
+        // Runs on a thread-pool thread: hand off to the UI thread
+        PostMessageW(g_hMainWnd, WM_PROCESS_EXITED, (WPARAM)(ULONG_PTR)context, 0);
+    }
+
+    void TrackHidden(HWND hwnd) {
+        DWORD pid = 0;
+        GetWindowThreadProcessId(hwnd, &pid);
+        if (pid == 0) return;
+
+        if (!g_windowReaper.Track(reinterpret_cast<uint64_t>(hwnd), pid)) return;
+
+        // First hidden window of this process: wait for the process to exit
+        ProcessWait wait = { OpenProcess(SYNCHRONIZE, FALSE, pid), nullptr };
+        if (!wait.hProcess) return;
+        if (!RegisterWaitForSingleObject(&wait.hWait, wait.hProcess, ProcessExitCallback,
+                                         (PVOID)(ULONG_PTR)pid, INFINITE, WT_EXECUTEONLYONCE)) {
+            CloseHandle(wait.hProcess);
+            return;
+        }
+        m_processWaits[pid] = wait;
+    }
+
+    void UntrackHidden(HWND hwnd) {
+        if (auto pid = g_windowReaper.Untrack(reinterpret_cast<uint64_t>(hwnd))) {
+            ReleaseProcessWait(*pid);
+        }
+    }
+
+    void ReleaseProcessWait(DWORD pid) {
+        auto it = m_processWaits.find(pid);
+        if (it == m_processWaits.end()) return;
+        // Blocks only while an in-flight callback finishes posting its message
+        UnregisterWaitEx(it->second.hWait, INVALID_HANDLE_VALUE);
+        CloseHandle(it->second.hProcess);
+        m_processWaits.erase(it);
+    }
+
+    // Drop every hidden window whose window or process died since the last flush
+    void ReapDeadWindows() {
+        ReapBatch reaped = g_windowReaper.TakeBatch();
+        if (reaped.windows.empty()) return;
+
+        WindowBatch batch;
+        for (uint64_t handleVal : reaped.windows) {
+            batch.Forget(handleVal);
+        }
+        batch.Commit(*this);
+
+        for (uint32_t pid : reaped.releasedProcesses) {
+            ReleaseProcessWait(pid);
+        }
+    }
+
+    // --- BatchBackend: the Win32 side of WindowBatch::Commit ---
+    bool AddTrayIcon(uint64_t window) override {
+        HWND hTarget = reinterpret_cast<HWND>(window);
+
+        // Check if already hidden
+        if (m_hiddenWindows.Contains(window)) return false;
+
+        // Get Icon (a hung window must not stall the UI thread)
+        DWORD_PTR iconResult = 0;
+        HICON hIcon = nullptr;
+        if (SendMessageTimeoutW(hTarget, WM_GETICON, ICON_SMALL, 0, SMTO_BLOCK | SMTO_ABORTIFHUNG, 100, &iconResult)) {
+            hIcon = (HICON)iconResult;
+        }
+        if (!hIcon) hIcon = (HICON)GetClassLongPtrW(hTarget, GCLP_HICONSM);
+        if (!hIcon) hIcon = LoadIconW(nullptr, IDI_APPLICATION); // Fallback
+
+        // Setup Tray Icon
+        NOTIFYICONDATAW nid = { sizeof(NOTIFYICONDATAW) };
+        nid.hWnd = m_mainWindow;
+        nid.uID = static_cast<UINT>(reinterpret_cast<UINT_PTR>(hTarget)); // Unique ID based on HWND
+        nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
+        nid.uCallbackMessage = WM_TRAYICON;
+        nid.hIcon = hIcon;
+        
+        // Get Window Title for Tooltip
+        GetWindowTextW(hTarget, nid.szTip, 128);
+
+        if (!Shell_NotifyIconW(NIM_ADD, &nid)) return false;
+        m_hiddenWindows.Insert(window, nid);
+        TrackHidden(hTarget);
+        return true;
+    }
+
+    bool RemoveTrayIcon(uint64_t window) override {
+        NOTIFYICONDATAW* iconData = m_hiddenWindows.Find(window);
+        if (!iconData) return false;
+
+        Shell_NotifyIconW(NIM_DELETE, iconData);
+        m_hiddenWindows.Erase(window);
+        UntrackHidden(reinterpret_cast<HWND>(window));
+        return true;
+    }
+
+    void ApplyWindowOps(const std::vector<WindowOp>& ops) override {
+        // Hides use ShowWindow so activation leaves a hidden foreground window (SetWindowPos
+        // would keep focus on it). The foreground window goes last, once restored windows are up.
+        HWND foreground = GetForegroundWindow();
+        bool hideForeground = false;
+        std::vector<HWND> shows;
+        for (const auto& op : ops) {
+            HWND hwnd = reinterpret_cast<HWND>(op.window);
+            if (op.kind == WindowOpKind::Show) {
+                shows.push_back(hwnd);
+            } else if (hwnd == foreground) {
+                hideForeground = true;
+            } else {
+                ShowWindow(hwnd, SW_HIDE);
+            }
+        }
+        ShowWindows(shows);
+        if (hideForeground) ShowWindow(foreground, SW_HIDE);
+    }
+
+    // Several restores are shown in one deferred position update so they appear in a single
+    // pass; a lone window, or a group that cannot be built, uses plain ShowWindow
+    static void ShowWindows(const std::vector<HWND>& windows) {
+        if (windows.size() > 1) {
+            HDWP hdwp = BeginDeferWindowPos(static_cast<int>(windows.size()));
+            for (HWND hwnd : windows) {
+                if (!hdwp) break;
+                hdwp = DeferWindowPos(hdwp, hwnd, nullptr, 0, 0, 0, 0,
+                                      SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_NOACTIVATE | SWP_SHOWWINDOW);
+            }
+            if (hdwp && EndDeferWindowPos(hdwp)) return;
+        }
+        for (HWND hwnd : windows) ShowWindow(hwnd, SW_SHOW);
+    }
+
+    void CommitState() override {
+        SaveState();
+    }
+
+    // --- Recovery from Explorer restarts ---
+    void BeginTrayRebuild() {
+        CreateTrayIcon();
+
+        m_trayRebuild.Begin(m_hiddenWindows.Windows());
+
+        // First burst right away, the rest paced by the timer
+        if (!StepTrayRebuild()) SetTimer(m_mainWindow, TIMER_TRAY_REBUILD, TRAY_REBUILD_INTERVAL_MS, nullptr);
+    }
+
+    bool StepTrayRebuild() {
+        // Icons come from the cached NOTIFYICONDATA, never from WM_GETICON
+        bool done = m_trayRebuild.Step([this](uint64_t window) {
+            NOTIFYICONDATAW* iconData = m_hiddenWindows.Find(window);
+            if (!iconData) return TrayAddResult::Gone; // Restored or reaped meanwhile
+            bool added = Shell_NotifyIconW(NIM_ADD, iconData) || Shell_NotifyIconW(NIM_MODIFY, iconData);
+            return added ? TrayAddResult::Added : TrayAddResult::Failed;
+        });
+        if (!done) return false;
+
+        KillTimer(m_mainWindow, TIMER_TRAY_REBUILD);
+
+        const TrayRebuildReport& report = m_trayRebuild.Report();
+        if (report.restored + report.failed > 0) {
+            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(report.elapsed).count();
+            std::wstring msg = L"Explorer restarted: re-added " + std::to_wstring(report.restored) +
+                               L" tray icons in " + std::to_wstring(ms) + L" ms.";
+            if (report.failed > 0) msg += L" " + std::to_wstring(report.failed) + L" could not be re-added.";
+            ShowBalloonTip(L"Tray Restored", msg.c_str());
+        }
+        return true;
+    }
+
     void CreateTrayIcon() {
         NOTIFYICONDATAW nid = { sizeof(NOTIFYICONDATAW) };
         nid.hWnd = m_mainWindow;
@@ -774,7 +1307,10 @@ private:
 
     void CreateTrayMenu() {
         m_trayMenu = CreatePopupMenu();
+        AppendMenuW(m_trayMenu, MF_STRING, MENU_MINIMIZE_APP_ID, L"Minimize All Windows of Current App");
+        AppendMenuW(m_trayMenu, MF_STRING, MENU_MINIMIZE_MONITOR_ID, L"Minimize All Windows on This Monitor");
         AppendMenuW(m_trayMenu, MF_STRING, MENU_RESTORE_ALL_ID, L"Restore All Windows");
+        AppendMenuW(m_trayMenu, MF_STRING, MENU_AUTO_MINIMIZE_STATS_ID, L"Auto-Minimize Statistics");
         AppendMenuW(m_trayMenu, MF_STRING, MENU_SETTINGS_ID, L"Settings...");
         AppendMenuW(m_trayMenu, MF_SEPARATOR, 0, nullptr);
         AppendMenuW(m_trayMenu, MF_STRING, MENU_EXIT_ID, L"Exit");
@@ -787,60 +1323,53 @@ private:
             return;
         }
 
-        std::ofstream outFile(DATA_FILENAME, std::ios::binary | std::ios::trunc);
-        if (!outFile) return;
-
-        for (const auto& hw : m_hiddenWindows) {
-            // Save HWND as 64-bit integer (safe for x64)
-            uint64_t handleVal = reinterpret_cast<uint64_t>(hw.hWnd);
-            outFile.write(reinterpret_cast<const char*>(&handleVal), sizeof(handleVal));
-        }
+        // Windows still waiting for recovery stay in the file in case we crash again
+        SaveHiddenState(DATA_FILENAME, m_recovery.WithRemaining(m_hiddenWindows.Windows()));
     }
 
     void LoadState() {
-        if (!std::filesystem::exists(DATA_FILENAME)) return;
+        // Only read the file here; StepRecovery re-minimizes from the message loop
+        m_recovery.Begin(LoadHiddenState(DATA_FILENAME));
+    }
 
-        std::ifstream inFile(DATA_FILENAME, std::ios::binary);
-        if (!inFile) return;
+    // Re-minimize valid windows after a crash, one batch per chunk
+    void StepRecovery() {
+        if (!m_startupTrace.InPhase()) m_startupTrace.Begin("recovery");
 
-        uint64_t handleVal;
-        int restoredCount = 0;
-        
-        while (inFile.read(reinterpret_cast<char*>(&handleVal), sizeof(handleVal))) {
-            HWND hwnd = reinterpret_cast<HWND>(handleVal);
-            if (IsWindow(hwnd)) {
-                // Re-minimize valid windows after a crash
-                NOTIFYICONDATAW nid = { sizeof(NOTIFYICONDATAW) };
-                nid.hWnd = m_mainWindow;
-                nid.uID = static_cast<UINT>(handleVal);
-                nid.uFlags = NIF_ICON | NIF_MESSAGE | NIF_TIP;
-                nid.uCallbackMessage = WM_TRAYICON;
-                
-                HICON hIcon = (HICON)SendMessageW(hwnd, WM_GETICON, ICON_SMALL, 0);
-                if (!hIcon) hIcon = (HICON)GetClassLongPtrW(hwnd, GCLP_HICONSM);
-                if (!hIcon) hIcon = LoadIconW(nullptr, IDI_APPLICATION);
-                nid.hIcon = hIcon;
-
-                GetWindowTextW(hwnd, nid.szTip, 128);
-
-                if (Shell_NotifyIconW(NIM_ADD, &nid)) {
-                    ShowWindow(hwnd, SW_HIDE);
-                    m_hiddenWindows.push_back({ hwnd, nid });
-                    restoredCount++;
-                }
-            }
+        RecoveryStep step = m_recovery.StepBatch(RECOVERY_CHUNK, *this, [this](uint64_t handleVal) {
+            return CanMinimize(reinterpret_cast<HWND>(handleVal));
+        });
+        if (!step.done) {
+            // Yield to hotkeys and input before the next chunk
+            PostMessageW(m_mainWindow, WM_RECOVER_STEP, 0, 0);
+            return;
         }
+
+        m_startupTrace.End();
+        WriteStartupTrace();
         
-        if (restoredCount > 0) {
-            std::wstring msg = L"Restored " + std::to_wstring(restoredCount) + L" hidden windows from previous session.";
-            MessageBoxW(nullptr, msg.c_str(), APP_TITLE, MB_OK | MB_ICONINFORMATION);
+        if (m_recovery.Recovered() > 0) {
+            std::wstring msg = L"Restored " + std::to_wstring(m_recovery.Recovered()) + L" hidden windows from previous session.";
+            ShowBalloonTip(L"Crash Recovery", msg.c_str());
         }
     }
+
+    void WriteStartupTrace() {
+        if (!m_startupTrace.Enabled()) return;
+
+        std::string report = m_startupTrace.Format();
+        std::ofstream outfile(STARTUP_TRACE_FILE, std::ios::trunc);
+        outfile << report;
+        OutputDebugStringA(report.c_str());
+    }
 };
 
 // Main Entry Point (Unicode)
-int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR, int) {
-    TraymondApp app(hInstance);
+int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, LPWSTR lpCmdLine, int) {
+    // --trace-startup writes per-phase startup timings to traymond_startup.log
+    bool traceStartup = lpCmdLine && wcsstr(lpCmdLine, L"--trace-startup") != nullptr;
+
+    TraymondApp app(hInstance, traceStartup);
     if (app.Initialize()) {
         app.Run();
     }
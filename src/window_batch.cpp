@@ -0,0 +1,57 @@
+#include "window_batch.h"
+
+void WindowBatch::Stage(uint64_t window, Action action) {
+    auto [it, inserted] = m_index.try_emplace(window, m_staged.size());
+    if (inserted) {
+        m_staged.push_back({ window, action });
+    } else {
+        m_staged[it->second].action = action;
+    }
+}
+
+BatchResult WindowBatch::Commit(BatchBackend& backend) {
+    BatchResult result;
+    std::vector<WindowOp> ops;
+    ops.reserve(m_staged.size());
+
+    // 1. Tray icons first: a window is only hidden once it is reachable from the tray
+    for (const auto& s : m_staged) {
+        if (s.action != Action::Hide) continue;
+        if (backend.AddTrayIcon(s.window)) {
+            ops.push_back({ s.window, WindowOpKind::Hide });
+            result.hidden++;
+        } else {
+            result.skipped++;
+        }
+    }
+
+    // 2. All shows and hides as one group
+    for (const auto& s : m_staged) {
+        if (s.action == Action::Restore) {
+            ops.push_back({ s.window, WindowOpKind::Show });
+        } else if (s.action == Action::Rehide) {
+            ops.push_back({ s.window, WindowOpKind::Hide });
+            result.rehidden++;
+        }
+    }
+    if (!ops.empty()) backend.ApplyWindowOps(ops);
+
+    // 3. Tray icons of restored and dead windows go last, after their windows are back
+    for (const auto& s : m_staged) {
+        if (s.action == Action::Hide || s.action == Action::Rehide) continue;
+        if (!backend.RemoveTrayIcon(s.window)) {
+            result.skipped++;
+        } else if (s.action == Action::Restore) {
+            result.restored++;
+        } else {
+            result.forgotten++;
+        }
+    }
+
+    // 4. One state write for the whole batch
+    if (result.hidden + result.restored + result.forgotten > 0) backend.CommitState();
+
+    m_staged.clear();
+    m_index.clear();
+    return result;
+}
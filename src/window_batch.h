@@ -0,0 +1,79 @@
+#pragma once
+
+// Transactional batch of minimize/restore operations. Changes are staged,
+// then committed in a fixed order: tray adds, one grouped window show/hide,
+// tray deletes, and a single state write.
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+enum class WindowOpKind {
+    Hide,
+    Show,
+};
+
+struct WindowOp {
+    uint64_t window;
+    WindowOpKind kind;
+};
+
+// Side effects of a commit; implemented over Win32 in traymond.cpp
+class BatchBackend {
+public:
+    virtual ~BatchBackend() = default;
+
+    // Adds the tray icon and records the window as hidden. False skips the window.
+    virtual bool AddTrayIcon(uint64_t window) = 0;
+    // Deletes the tray icon and drops the hidden record. False if it was not hidden.
+    virtual bool RemoveTrayIcon(uint64_t window) = 0;
+    // Applies every show/hide of the batch as one group
+    virtual void ApplyWindowOps(const std::vector<WindowOp>& ops) = 0;
+    // Persists the hidden-window table; called at most once per commit
+    virtual void CommitState() = 0;
+};
+
+struct BatchResult {
+    size_t hidden = 0;
+    size_t restored = 0;
+    size_t forgotten = 0;
+    size_t rehidden = 0;
+    size_t skipped = 0;
+};
+
+class WindowBatch {
+public:
+    // Staging the same window again replaces its earlier operation
+    void Hide(uint64_t window) { Stage(window, Action::Hide); }
+    void Restore(uint64_t window) { Stage(window, Action::Restore); }
+    // Drop the tray icon only; the window itself is already gone
+    void Forget(uint64_t window) { Stage(window, Action::Forget); }
+    // Hide a window that is still hidden but showed itself again; its tray icon and
+    // the state file already record it
+    void Rehide(uint64_t window) { Stage(window, Action::Rehide); }
+
+    bool Empty() const { return m_staged.empty(); }
+    size_t Size() const { return m_staged.size(); }
+
+    // Runs the staged operations against the backend and clears the batch
+    BatchResult Commit(BatchBackend& backend);
+
+private:
+    enum class Action {
+        Hide,
+        Restore,
+        Forget,
+        Rehide,
+    };
+
+    struct Staged {
+        uint64_t window;
+        Action action;
+    };
+
+    void Stage(uint64_t window, Action action);
+
+    std::vector<Staged> m_staged;
+    std::unordered_map<uint64_t, size_t> m_index;
+};
@@ -0,0 +1,93 @@
+#include "window_reaper.h"
+
+#include <algorithm>
+
+bool WindowReaper::Track(uint64_t window, uint32_t pid) {
+    auto [it, inserted] = m_windows.try_emplace(window, Entry{ pid, false });
+    if (!inserted) return false;
+
+    auto& siblings = m_processes[pid];
+    siblings.push_back(window);
+    return siblings.size() == 1;
+}
+
+std::optional<uint32_t> WindowReaper::Untrack(uint64_t window) {
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) return std::nullopt;
+
+    uint32_t pid = it->second.pid;
+    if (it->second.pending) {
+        // Restored (or otherwise removed) before the flush ran
+        m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+            [window](const PendingReap& p) { return p.window == window; }), m_pending.end());
+    }
+    m_windows.erase(it);
+
+    if (ReleaseFromProcess(window, pid)) return pid;
+    return std::nullopt;
+}
+
+bool WindowReaper::OnWindowDestroyed(uint64_t window, Clock::time_point now) {
+    auto it = m_windows.find(window);
+    if (it == m_windows.end()) return false;
+    return MarkPending(window, it->second, now);
+}
+
+bool WindowReaper::OnProcessExited(uint32_t pid, Clock::time_point now) {
+    auto proc = m_processes.find(pid);
+    if (proc == m_processes.end()) return false;
+
+    bool scheduleFlush = false;
+    for (uint64_t window : proc->second) {
+        if (MarkPending(window, m_windows.at(window), now)) scheduleFlush = true;
+    }
+    return scheduleFlush;
+}
+
+ReapBatch WindowReaper::TakeBatch(Clock::time_point now) {
+    ReapBatch batch;
+    if (m_pending.empty()) return batch;
+
+    batch.windows.reserve(m_pending.size());
+    for (const auto& p : m_pending) {
+        auto it = m_windows.find(p.window);
+        if (it == m_windows.end()) continue;
+
+        uint32_t pid = it->second.pid;
+        m_windows.erase(it);
+        if (ReleaseFromProcess(p.window, pid)) batch.releasedProcesses.push_back(pid);
+        batch.windows.push_back(p.window);
+
+        auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - p.markedAt);
+        m_stats.totalLatency += latency;
+        m_stats.maxLatency = std::max(m_stats.maxLatency, latency);
+    }
+    m_pending.clear();
+
+    m_stats.reapedWindows += batch.windows.size();
+    m_stats.batches++;
+    return batch;
+}
+
+bool WindowReaper::MarkPending(uint64_t window, Entry& entry, Clock::time_point now) {
+    if (entry.pending) return false;
+    entry.pending = true;
+    m_pending.push_back({ window, now });
+    return m_pending.size() == 1;
+}
+
+bool WindowReaper::ReleaseFromProcess(uint64_t window, uint32_t pid) {
+    auto proc = m_processes.find(pid);
+    if (proc == m_processes.end()) return false;
+
+    auto& siblings = proc->second;
+    auto pos = std::find(siblings.begin(), siblings.end(), window);
+    if (pos != siblings.end()) {
+        *pos = siblings.back();
+        siblings.pop_back();
+    }
+    if (!siblings.empty()) return false;
+
+    m_processes.erase(proc);
+    return true;
+}
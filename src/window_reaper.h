@@ -0,0 +1,71 @@
+#pragma once
+
+// Portable bookkeeping for reaping hidden windows whose window or owning
+// process has died. Win32 specifics (event hooks, process waits) live in
+// traymond.cpp; this class only decides what is stale and batches it.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+struct ReapStats {
+    uint64_t reapedWindows = 0;
+    uint64_t batches = 0;
+    std::chrono::nanoseconds totalLatency{ 0 };
+    std::chrono::nanoseconds maxLatency{ 0 };
+};
+
+// Windows dropped by one flush, plus the processes that no longer need a wait
+struct ReapBatch {
+    std::vector<uint64_t> windows;
+    std::vector<uint32_t> releasedProcesses;
+};
+
+class WindowReaper {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Start tracking a hidden window. Returns true if this is the first window
+    // of the process, i.e. the caller should register a process wait.
+    bool Track(uint64_t window, uint32_t pid);
+
+    // Stop tracking (window restored by the user). Returns the pid if its last
+    // window went away, so the caller can release the process wait.
+    std::optional<uint32_t> Untrack(uint64_t window);
+
+    bool IsTracked(uint64_t window) const { return m_windows.count(window) > 0; }
+    size_t TrackedCount() const { return m_windows.size(); }
+    size_t PendingCount() const { return m_pending.size(); }
+
+    // Mark entries as dead. Both return true when the pending batch went from
+    // empty to non-empty, i.e. the caller should schedule exactly one flush.
+    bool OnWindowDestroyed(uint64_t window, Clock::time_point now = Clock::now());
+    bool OnProcessExited(uint32_t pid, Clock::time_point now = Clock::now());
+
+    // Drain everything marked dead since the last flush
+    ReapBatch TakeBatch(Clock::time_point now = Clock::now());
+
+    const ReapStats& Stats() const { return m_stats; }
+
+private:
+    struct Entry {
+        uint32_t pid;
+        bool pending;
+    };
+
+    struct PendingReap {
+        uint64_t window;
+        Clock::time_point markedAt;
+    };
+
+    bool MarkPending(uint64_t window, Entry& entry, Clock::time_point now);
+    bool ReleaseFromProcess(uint64_t window, uint32_t pid);
+
+    std::unordered_map<uint64_t, Entry> m_windows;
+    std::unordered_map<uint32_t, std::vector<uint64_t>> m_processes;
+    std::vector<PendingReap> m_pending;
+    ReapStats m_stats;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+// Minimal test harness for the core library: TEST(name) registers a case,
+// CHECK records a failure and keeps going. Each *_test.cpp links test_main.cpp.
+
+#include <cstdio>
+#include <vector>
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& TestRegistry();
+void ReportFailure(const char* file, int line, const char* expression);
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*run)()) { TestRegistry().push_back({ name, run }); }
+};
+
+#define TEST(name)                                              \
+    static void name();                                         \
+    static const TestRegistrar name##_registrar(#name, &name);  \
+    static void name()
+
+#define CHECK(condition)                                                  \
+    do {                                                                  \
+        if (!(condition)) ReportFailure(__FILE__, __LINE__, #condition);  \
+    } while (0)
+
+#define CHECK_EQ(a, b) CHECK((a) == (b))
@@ -0,0 +1,39 @@
+#include "config.h"
+
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+std::string ToBytes(std::u16string_view text) {
+    return std::string(text.begin(), text.end());
+}
+
+} // namespace
+
+TEST(AutoListChildPrefixRoundTrips) {
+    std::vector<AutoListEntry> entries = {
+        { u"C:\\Games\\Launcher.exe", true },
+        { u"C:\\Windows\\notepad.exe", false },
+        { u"\\\\server\\share\\tool.exe", true },
+    };
+
+    // SaveAutoList writes one line per entry, one byte per unit, CRLF on Windows
+    std::string file;
+    for (const auto& entry : entries) file += ToBytes(FormatAutoListLine(entry)) + "\r\n";
+    CHECK(file.substr(0, 2) == ">C");
+
+    auto parsed = ParseAutoList(file);
+    CHECK_EQ(parsed.size(), entries.size());
+    for (size_t i = 0; i < parsed.size() && i < entries.size(); i++) {
+        CHECK(parsed[i].path == entries[i].path);
+        CHECK_EQ(parsed[i].includeChildren, entries[i].includeChildren);
+    }
+
+    // A lone '>' is an empty rule and is dropped; old files without prefixes still load
+    CHECK(ParseAutoList(">\n").empty());
+    auto legacy = ParseAutoList("C:\\a.exe\nC:\\b.exe");
+    CHECK(legacy.size() == 2 && !legacy[0].includeChildren && !legacy[1].includeChildren);
+}
@@ -0,0 +1,164 @@
+#include "path_key.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+// Straightforward reimplementation of the rules in path_key.h, sharing no code
+// with the kernels: strip the prefix, then fold and collapse one unit at a time.
+bool RefIsSep(char16_t c) { return c == u'\\' || c == u'/'; }
+
+char16_t RefFold(char16_t c) {
+    if (c == u'/') return u'\\';
+    if (u'A' <= c && c <= u'Z') return c + 0x20;
+    if (0xC0 <= c && c <= 0xDE && c != 0xD7) return c + 0x20;
+    return c;
+}
+
+bool RefSepAt(std::u16string_view s, size_t i) { return i < s.size() && RefIsSep(s[i]); }
+
+bool RefLetter(char16_t c) { return (u'a' <= c && c <= u'z') || (u'A' <= c && c <= u'Z'); }
+
+std::u16string ReferenceCanonical(std::u16string_view s) {
+    std::u16string out;
+    std::u16string_view body = s;
+
+    bool extended = RefSepAt(s, 0) && RefSepAt(s, 1) && s.size() >= 4 && (s[2] == u'?' || s[2] == u'.') && RefSepAt(s, 3);
+    if (extended && s[2] == u'?' && s.size() >= 8 && RefFold(s[4]) == u'u' && RefFold(s[5]) == u'n' &&
+        RefFold(s[6]) == u'c' && RefSepAt(s, 7)) {
+        out = u"\\\\";
+        body = s.substr(8);
+    } else {
+        if (extended && (s[2] == u'?' || (s.size() >= 6 && RefLetter(s[4]) && s[5] == u':'))) {
+            body = s.substr(4);
+        } else if (!extended && RefSepAt(s, 0) && s.size() >= 4 && s[1] == u'?' && s[2] == u'?' && RefSepAt(s, 3)) {
+            body = s.substr(4);
+        }
+        if (RefSepAt(body, 0) && RefSepAt(body, 1)) {
+            out = u"\\\\";
+            body = body.substr(2);
+        }
+    }
+
+    for (char16_t c : body) {
+        c = RefFold(c);
+        if (c == u'\\' && !out.empty() && out.back() == u'\\') continue;
+        out.push_back(c);
+    }
+
+    bool driveRoot = out.size() == 3 && out[1] == u':';
+    bool uncRoot = out == u"\\\\";
+    if (out.size() >= 2 && out.back() == u'\\' && !driveRoot && !uncRoot) out.pop_back();
+    return out;
+}
+
+const PathKeyKernel kKernels[] = { PathKeyKernel::Scalar, PathKeyKernel::Sse2, PathKeyKernel::Avx2 };
+
+// Every supported kernel matches the reference; returns how many kernels ran
+int CheckAllKernels(std::u16string_view path) {
+    std::u16string expected = ReferenceCanonical(path);
+    uint64_t expectedHash = HashPathKey(expected);
+    int ran = 0;
+    for (PathKeyKernel kernel : kKernels) {
+        if (!PathKeyKernelSupported(kernel)) continue;
+        PathKey key = MakePathKeyWith(path, kernel);
+        bool ok = key.canonical == expected && key.hash == expectedHash;
+        if (!ok) {
+            std::fprintf(stderr, "kernel %s differs from reference on input of %zu units\n",
+                         PathKeyKernelName(kernel), path.size());
+        }
+        CHECK(ok);
+        ran++;
+    }
+    CHECK(MakePathKey(path).canonical == expected);
+    return ran;
+}
+
+} // namespace
+
+TEST(ReferenceMatchesDocumentedRules) {
+    CHECK(ReferenceCanonical(u"\\\\?\\UNC\\Server\\Share\\") == u"\\\\server\\share");
+    CHECK(ReferenceCanonical(u"\\??\\C:\\X") == u"c:\\x");
+    CHECK(ReferenceCanonical(u"\\\\.\\C:/X") == u"c:\\x");
+    CHECK(ReferenceCanonical(u"\\\\.\\pipe\\Foo") == u"\\\\.\\pipe\\foo");
+    CHECK(ReferenceCanonical(u"C:\\") == u"c:\\");
+    CHECK(ReferenceCanonical(u"C://a//") == u"c:\\a");
+    CHECK(ReferenceCanonical(u"\\\\") == u"\\\\");
+}
+
+TEST(KernelsMatchReferenceOnEdgeCases) {
+    const std::u16string edges[] = {
+        u"",
+        u"\\",
+        u"/",
+        u"\\\\",
+        u"////",
+        u"C:",
+        u"C:\\",
+        u"c:/",
+        u"C:\\\\",
+        u"\\\\server\\",
+        u"\\\\server\\share\\\\",
+        u"\\\\?\\C:\\Program Files\\App\\app.exe",
+        u"\\\\?\\UNC\\fileserver\\apps\\Tool.exe",
+        u"\\\\?\\unc/fileserver/apps/Tool.exe",
+        u"\\\\?\\UNC\\",
+        u"\\\\?\\UNC",
+        u"\\??\\C:\\Windows\\notepad.exe",
+        u"\\??\\UNC\\server\\share",
+        u"\\\\.\\pipe\\traymond",
+        u"\\\\.\\C:\\Windows",
+        u"\\\\.\\",
+        u"\\\\?\\",
+        u"C:\\Program Files\\\u00C0\u00D7\u00DE\u00DF\u00BF\u00C6\\App.EXE",
+        u"C:\\\xD83D\xDE00\\\xDBFF\xDFFF\\\xFFFF\x8000\xD800.exe",
+    };
+    for (const auto& path : edges) CHECK(CheckAllKernels(path) >= 1);
+}
+
+TEST(DoubledSeparatorsAtEveryChunkOffset) {
+    // A "\\" or "/\\" pair straddling every position of the 8- and 16-unit chunks
+    for (size_t offset = 0; offset < 48; offset++) {
+        for (const char16_t* pair : { u"\\\\", u"/\\", u"//", u"\\/" }) {
+            std::u16string path = u"C:\\" + std::u16string(offset, u'A') + pair + u"Tail\\X.exe";
+            CheckAllKernels(path);
+            // Separator as the last unit of a chunk followed by one starting the next
+            CheckAllKernels(u"\\\\?\\" + path + u"\\\\");
+        }
+    }
+}
+
+TEST(KernelsMatchReferenceOnRandomInput) {
+    const char16_t alphabet[] = {
+        u'a', u'Z', u'M', u'0', u'.', u':', u'?', u' ', u'\\', u'\\', u'/', u'/',
+        0x00BF, 0x00C0, 0x00D7, 0x00DE, 0x00DF, 0x00E0, 0x0100, 0x7FFF, 0x8000, 0xD800, 0xDBFF, 0xDC00, 0xDFFF, 0xFFFF,
+    };
+    const std::u16string prefixes[] = { u"", u"\\\\?\\", u"\\\\?\\UNC\\", u"\\??\\", u"\\\\.\\", u"C:\\", u"\\\\" };
+
+    std::mt19937 rng(27);
+    for (int i = 0; i < 20000; i++) {
+        std::u16string path = prefixes[rng() % std::size(prefixes)];
+        size_t length = rng() % 80;
+        for (size_t k = 0; k < length; k++) path.push_back(alphabet[rng() % std::size(alphabet)]);
+        CheckAllKernels(path);
+    }
+}
+
+TEST(EquivalentSpellingsShareKey) {
+    PathKey a = MakePathKey(u"C:\\Program Files\\App\\App.exe");
+    CHECK(a == MakePathKey(u"\\\\?\\c:/program files//app/APP.EXE"));
+    CHECK(a == MakePathKey(u"\\??\\C:\\Program Files\\App\\App.exe\\"));
+    CHECK(!(a == MakePathKey(u"C:\\Program Files\\App\\App2.exe")));
+}
+
+TEST(UnsupportedKernelFallsBackToScalar) {
+    for (PathKeyKernel kernel : kKernels) {
+        PathKey key = MakePathKeyWith(u"C:\\A\\\\B", kernel);
+        CHECK(key.canonical == u"c:\\a\\b");
+    }
+    CHECK(PathKeyKernelSupported(PathKeyKernel::Scalar));
+}
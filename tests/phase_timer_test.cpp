@@ -0,0 +1,80 @@
+#include "phase_timer.h"
+
+#include "check.h"
+
+namespace {
+
+using Clock = PhaseTimer::Clock;
+using std::chrono::milliseconds;
+
+const Clock::time_point kStart = Clock::time_point{} + std::chrono::hours(1);
+
+} // namespace
+
+TEST(PhasesRecordOffsetAndDuration) {
+    PhaseTimer timer(true, kStart);
+    timer.Begin("config", kStart + milliseconds(2));
+    CHECK(timer.InPhase());
+    timer.End(kStart + milliseconds(5));
+    CHECK(!timer.InPhase());
+    timer.Begin("hook", kStart + milliseconds(7));
+    timer.End(kStart + milliseconds(8));
+
+    const auto& phases = timer.Phases();
+    CHECK_EQ(phases.size(), 2u);
+    CHECK(phases[0].name == "config");
+    CHECK(phases[0].offset == milliseconds(2));
+    CHECK(phases[0].duration == milliseconds(3));
+    CHECK(phases[1].name == "hook");
+    CHECK(phases[1].offset == milliseconds(7));
+    CHECK(phases[1].duration == milliseconds(1));
+
+    // Gaps between phases are not part of the total
+    CHECK(timer.Total() == milliseconds(4));
+}
+
+TEST(BeginEndsTheCurrentPhase) {
+    PhaseTimer timer(true, kStart);
+    timer.Begin("a", kStart);
+    timer.Begin("b", kStart + milliseconds(10));  // Phases do not nest: "a" ends here
+    timer.Begin("c", kStart + milliseconds(15));
+    timer.End(kStart + milliseconds(16));
+    timer.End(kStart + milliseconds(99));  // Nothing open: ignored
+
+    const auto& phases = timer.Phases();
+    CHECK_EQ(phases.size(), 3u);
+    CHECK(phases[0].duration == milliseconds(10));
+    CHECK(phases[1].offset == milliseconds(10));
+    CHECK(phases[1].duration == milliseconds(5));
+    CHECK(phases[2].duration == milliseconds(1));
+    CHECK(timer.Total() == milliseconds(16));
+
+    // A phase still open has no duration yet
+    PhaseTimer open(true, kStart);
+    open.Begin("pending", kStart + milliseconds(1));
+    CHECK(open.Phases()[0].duration == milliseconds(0));
+    CHECK(open.Total() == milliseconds(0));
+}
+
+TEST(DisabledTimerRecordsNothing) {
+    PhaseTimer timer(false, kStart);
+    timer.Begin("a", kStart);
+    timer.End(kStart + milliseconds(1));
+    CHECK(!timer.Enabled());
+    CHECK(!timer.InPhase());
+    CHECK(timer.Phases().empty());
+    CHECK(timer.Total() == milliseconds(0));
+}
+
+TEST(FormatPrintsOneLinePerPhaseAndTotal) {
+    PhaseTimer timer(true, kStart);
+    timer.Begin("load config", kStart + std::chrono::microseconds(1500));
+    timer.Begin("install hook", kStart + milliseconds(4));
+    timer.End(kStart + milliseconds(4) + std::chrono::microseconds(250));
+
+    CHECK(timer.Format() ==
+          "     1.500 ms      2.500 ms  load config\n"
+          "     4.000 ms      0.250 ms  install hook\n"
+          "                   2.750 ms  total\n");
+    CHECK(PhaseTimer(true, kStart).Format() == "                   0.000 ms  total\n");
+}
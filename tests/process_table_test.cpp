@@ -0,0 +1,115 @@
+#include "process_table.h"
+
+#include <string>
+
+#include "auto_rules.h"
+#include "check.h"
+
+namespace {
+
+ProcessRecord Record(uint32_t parentPid, uint64_t startTime, std::u16string_view image) {
+    return { parentPid, startTime, MakePathKey(image) };
+}
+
+// launcher (10) -> app (20) -> helper (30); unrelated shell (4) -> tool (40)
+ProcessTable LauncherTree() {
+    ProcessTable table;
+    table.Upsert(4, Record(0, 1, u"C:\\Windows\\explorer.exe"));
+    table.Upsert(10, Record(4, 10, u"C:\\Games\\Launcher.exe"));
+    table.Upsert(20, Record(10, 20, u"C:\\Games\\App\\app.exe"));
+    table.Upsert(30, Record(20, 30, u"C:\\Games\\App\\helper.exe"));
+    table.Upsert(40, Record(4, 40, u"C:\\Tools\\tool.exe"));
+    return table;
+}
+
+} // namespace
+
+TEST(AncestorWalkVisitsNearestFirst) {
+    ProcessTable table = LauncherTree();
+    std::vector<uint32_t> visited;
+    CHECK(!table.AnyAncestor(30, [&](uint32_t pid, const ProcessRecord&) {
+        visited.push_back(pid);
+        return false;
+    }));
+    CHECK(visited == (std::vector<uint32_t>{ 20, 10, 4 }));
+}
+
+TEST(TreeRuleMatchesDescendants) {
+    ProcessTable table = LauncherTree();
+    AutoMinimizeRules rules;
+    rules.Add(u"c:/games/launcher.exe", true);
+
+    CHECK(rules.MatchesProcess(table, 10));  // The launcher itself
+    CHECK(rules.MatchesProcess(table, 20));
+    CHECK(rules.MatchesProcess(table, 30));  // Grandchild
+    CHECK(!rules.MatchesProcess(table, 40));
+    CHECK(!rules.MatchesProcess(table, 4));
+    CHECK(!rules.MatchesProcess(table, 99));  // Unknown pid
+
+    // Without the flag only the launcher's own windows match
+    rules.SetIncludeChildren(0, false);
+    CHECK(rules.MatchesProcess(table, 10));
+    CHECK(!rules.MatchesProcess(table, 30));
+    CHECK(!rules.HasTreeRules());
+}
+
+TEST(WalkStopsAtReusedPid) {
+    ProcessTable table = LauncherTree();
+    AutoMinimizeRules rules;
+    rules.Add(u"C:\\Games\\Launcher.exe", true);
+
+    // The launcher exited and pid 10 now belongs to a process started after the app
+    table.Upsert(10, Record(4, 25, u"C:\\Games\\Launcher.exe"));
+    CHECK(!rules.MatchesProcess(table, 20));
+    CHECK(!rules.MatchesProcess(table, 30));
+
+    // Equal start times still count as a valid parent
+    table.Upsert(10, Record(4, 20, u"C:\\Games\\Launcher.exe"));
+    CHECK(rules.MatchesProcess(table, 30));
+}
+
+TEST(WalkStopsAtMaxDepthAndCycles) {
+    // Chain 1 <- 2 <- ... <- 40, each a child of the previous one
+    ProcessTable table;
+    table.Upsert(1, Record(0, 1, u"C:\\root.exe"));
+    for (uint32_t pid = 2; pid <= 40; pid++) table.Upsert(pid, Record(pid - 1, pid, u"C:\\child.exe"));
+
+    size_t depth = 0;
+    table.AnyAncestor(40, [&](uint32_t, const ProcessRecord&) { depth++; return false; });
+    CHECK_EQ(depth, ProcessTable::kMaxDepth);
+
+    AutoMinimizeRules rules;
+    rules.Add(u"C:\\root.exe", true);
+    CHECK(rules.MatchesProcess(table, 1 + ProcessTable::kMaxDepth));
+    CHECK(!rules.MatchesProcess(table, 2 + ProcessTable::kMaxDepth));
+
+    // Parent links that loop (same start time) end at kMaxDepth instead of spinning
+    ProcessTable loop;
+    loop.Upsert(60, Record(61, 5, u"C:\\a.exe"));
+    loop.Upsert(61, Record(60, 5, u"C:\\b.exe"));
+    depth = 0;
+    CHECK(!loop.AnyAncestor(60, [&](uint32_t, const ProcessRecord&) { depth++; return false; }));
+    CHECK_EQ(depth, ProcessTable::kMaxDepth);
+
+    // A process listing itself as parent has no ancestors
+    loop.Upsert(70, Record(70, 5, u"C:\\c.exe"));
+    CHECK(!loop.AnyAncestor(70, [](uint32_t, const ProcessRecord&) { return true; }));
+}
+
+TEST(EvictionDropsLeastRecentlyUsed) {
+    ProcessTable table = LauncherTree();
+    // Only the helper's chain was used since the tree was built
+    table.Touch(10);
+    table.Touch(20);
+    table.Touch(30);
+    CHECK(!table.Touch(99));
+
+    CHECK_EQ(table.EvictLeastRecentlyUsed(3), 2u);
+    CHECK_EQ(table.Size(), 3u);
+    CHECK(table.Find(10) && table.Find(20) && table.Find(30));
+    CHECK(!table.Find(4) && !table.Find(40));
+
+    CHECK_EQ(table.EvictLeastRecentlyUsed(5), 0u);
+    CHECK_EQ(table.EvictLeastRecentlyUsed(0), 3u);
+    CHECK_EQ(table.Size(), 0u);
+}
@@ -0,0 +1,149 @@
+#include "recovery_queue.h"
+
+#include <algorithm>
+#include <set>
+
+#include "check.h"
+#include "state_file.h"
+#include "window_batch.h"
+
+namespace {
+
+constexpr size_t kChunk = 32;  // RECOVERY_CHUNK
+
+// Backend over a set of hidden windows and the recovery queue; CommitState writes
+// what TraymondApp::SaveState writes, in the traymond_recovery.dat encoding
+struct RecoveringApp : BatchBackend {
+    std::set<uint64_t> hidden;
+    RecoveryQueue recovery;
+    std::string stateFile;
+    size_t writes = 0;
+
+    bool AddTrayIcon(uint64_t window) override { return hidden.insert(window).second; }
+    bool RemoveTrayIcon(uint64_t window) override { return hidden.erase(window) > 0; }
+    void ApplyWindowOps(const std::vector<WindowOp>&) override {}
+    void CommitState() override {
+        stateFile = EncodeHiddenState(recovery.WithRemaining({ hidden.begin(), hidden.end() }));
+        writes++;
+    }
+
+    // One WM_RECOVER_STEP
+    RecoveryStep Step(bool (*alive)(uint64_t)) { return recovery.StepBatch(kChunk, *this, alive); }
+};
+
+bool EveryTenthDead(uint64_t window) { return window % 10 != 0; }
+
+std::vector<uint64_t> Saved(uint64_t count) {
+    std::vector<uint64_t> windows;
+    for (uint64_t i = 0; i < count; i++) windows.push_back(0x1000 + i);
+    return windows;
+}
+
+std::multiset<uint64_t> Decoded(const std::string& stateFile) {
+    auto windows = DecodeHiddenState(stateFile);
+    return { windows.begin(), windows.end() };
+}
+
+} // namespace
+
+TEST(StepVisitsAtMostBudget) {
+    RecoveryQueue queue;
+    queue.Begin(Saved(70));
+    size_t visited = 0;
+    CHECK(!queue.Step(32, [&](uint64_t) { visited++; }));
+    CHECK_EQ(visited, 32u);
+    CHECK(!queue.Step(32, [&](uint64_t) { visited++; }));
+    CHECK(queue.Step(32, [&](uint64_t) { visited++; }));
+    CHECK_EQ(visited, 70u);
+    CHECK(!queue.Active());
+    CHECK(queue.Remaining().empty());
+}
+
+TEST(RecoversThousandWindowsInChunks) {
+    RecoveringApp app;
+    app.recovery.Begin(Saved(1000));
+
+    size_t steps = 0;
+    size_t recovered = 0;
+    bool done = false;
+    while (!done) {
+        RecoveryStep step = app.Step(EveryTenthDead);
+        recovered += step.hidden;
+        done = step.done;
+        steps++;
+
+        // After every chunk the state file holds exactly the hidden windows
+        // plus those not reached yet: nothing lost, nothing duplicated
+        std::multiset<uint64_t> expected(app.hidden.begin(), app.hidden.end());
+        for (uint64_t w : app.recovery.Remaining()) expected.insert(w);
+        CHECK(Decoded(app.stateFile) == expected);
+        CHECK_EQ(app.recovery.Visited(), std::min<size_t>(steps * kChunk, 1000));
+    }
+
+    CHECK_EQ(steps, (1000 + kChunk - 1) / kChunk);
+    CHECK_EQ(recovered, 900u);
+    CHECK_EQ(app.recovery.Recovered(), 900u);
+    CHECK_EQ(app.writes, steps);  // One state write per chunk
+    CHECK_EQ(Decoded(app.stateFile).size(), 900u);
+    for (uint64_t w : Decoded(app.stateFile)) CHECK(EveryTenthDead(w));  // Dead windows left the file
+}
+
+TEST(CrashMidRecoveryLosesNothing) {
+    RecoveringApp first;
+    first.recovery.Begin(Saved(1000));
+    for (int i = 0; i < 10; i++) CHECK(!first.Step(EveryTenthDead).done);
+
+    // The next session starts from whatever the file held at the crash
+    RecoveringApp second;
+    second.recovery.Begin(DecodeHiddenState(first.stateFile));
+    while (!second.Step(EveryTenthDead).done) {}
+
+    CHECK_EQ(second.hidden.size(), 900u);
+    CHECK_EQ(Decoded(second.stateFile).size(), 900u);
+}
+
+TEST(ChunkOfDeadWindowsStillRewritesState) {
+    RecoveringApp app;
+    app.recovery.Begin({ 10, 20, 30, 41 });
+    RecoveryStep step = app.recovery.StepBatch(3, app, EveryTenthDead);
+    CHECK_EQ(step.hidden, 0u);
+    CHECK(!step.done);
+    CHECK_EQ(app.writes, 1u);
+    CHECK(Decoded(app.stateFile) == (std::multiset<uint64_t>{ 41 }));
+}
+
+TEST(RestoreAllDropsRemainingFromState) {
+    RecoveringApp app;
+    app.recovery.Begin(Saved(100));
+    size_t recovered = app.Step(EveryTenthDead).hidden;
+    CHECK_EQ(recovered, app.hidden.size());
+
+    // Restore All: hidden windows come back, the rest of the queue is dropped
+    WindowBatch batch;
+    for (uint64_t w : std::vector<uint64_t>(app.hidden.begin(), app.hidden.end())) batch.Restore(w);
+    BatchResult result = app.recovery.RestoreAll(batch, app, EveryTenthDead);
+
+    CHECK_EQ(result.restored, recovered);
+    CHECK(!app.recovery.Active());
+    CHECK_EQ(app.recovery.Recovered(), recovered);
+    CHECK(Decoded(app.stateFile).empty());
+}
+
+TEST(RestoreAllWithNothingHiddenStillRewritesState) {
+    // Only queued windows, none with a tray icon: the batch writes nothing by itself
+    RecoveringApp app;
+    app.recovery.Begin(Saved(5));
+    app.CommitState();
+    size_t writes = app.writes;
+
+    WindowBatch batch;
+    BatchResult result = app.recovery.RestoreAll(batch, app, EveryTenthDead);
+    CHECK_EQ(result.restored, 0u);
+    CHECK_EQ(app.writes, writes + 1);
+    CHECK(Decoded(app.stateFile).empty());
+
+    // Nothing was queued: no extra write
+    WindowBatch empty;
+    app.recovery.RestoreAll(empty, app, EveryTenthDead);
+    CHECK_EQ(app.writes, writes + 1);
+}
@@ -0,0 +1,32 @@
+#include "check.h"
+
+#include <cstring>
+
+namespace {
+int g_failures = 0;
+}
+
+std::vector<TestCase>& TestRegistry() {
+    static std::vector<TestCase> registry;
+    return registry;
+}
+
+void ReportFailure(const char* file, int line, const char* expression) {
+    std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+    g_failures++;
+}
+
+// Usage: <test> [substring]  runs the cases whose name contains substring
+int main(int argc, char** argv) {
+    int failedCases = 0;
+    for (const auto& test : TestRegistry()) {
+        if (argc > 1 && !std::strstr(test.name, argv[1])) continue;
+
+        int before = g_failures;
+        test.run();
+        bool passed = g_failures == before;
+        if (!passed) failedCases++;
+        std::printf("[%s] %s\n", passed ? "  OK  " : " FAIL ", test.name);
+    }
+    return failedCases == 0 ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+#include "thrash_guard.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+using Clock = ThrashGuard::Clock;
+using std::chrono::milliseconds;
+
+constexpr uint64_t kWindow = 0x1234;
+constexpr uint32_t kPid = 77;
+
+const Clock::time_point kStart = Clock::time_point{} + std::chrono::hours(1);
+
+// Attempts for one window, one every step
+std::vector<ThrashDecision> Hammer(ThrashGuard& guard, Clock::time_point& now, milliseconds step, size_t attempts) {
+    std::vector<ThrashDecision> decisions;
+    for (size_t i = 0; i < attempts; i++, now += step) decisions.push_back(guard.OnHideAttempt(kWindow, kPid, now));
+    return decisions;
+}
+
+size_t Count(const std::vector<ThrashDecision>& decisions, ThrashDecision decision) {
+    size_t n = 0;
+    for (ThrashDecision d : decisions) n += d == decision;
+    return n;
+}
+
+// Plays TraymondApp's side: shows go through OnHideAttempt, backed-off windows are
+// retried through OnRetry at RetryAt, and a thrashing window shows again reshowAfter
+// every time it is hidden
+struct AutoMinimizeLoop {
+    enum class Event { Show, Retry };
+
+    ThrashGuard guard;
+    std::multimap<Clock::time_point, std::pair<uint64_t, Event>> events;
+    std::map<uint64_t, uint32_t> pids;
+    std::set<uint64_t> hidden;
+    std::set<uint64_t> thrashing;
+    milliseconds reshowAfter{ 16 };
+
+    void Show(uint64_t window, uint32_t pid, Clock::time_point at) {
+        pids[window] = pid;
+        events.emplace(at, std::make_pair(window, Event::Show));
+    }
+
+    void RunUntil(Clock::time_point end) {
+        while (!events.empty() && events.begin()->first <= end) {
+            auto [now, event] = *events.begin();
+            events.erase(events.begin());
+            auto [window, kind] = event;
+            uint32_t pid = pids[window];
+
+            ThrashDecision decision = kind == Event::Show ? guard.OnHideAttempt(window, pid, now)
+                                                          : guard.OnRetry(window, pid, now);
+            if (decision == ThrashDecision::Allow) {
+                hidden.insert(window);
+                if (thrashing.count(window)) {
+                    hidden.erase(window);
+                    events.emplace(now + reshowAfter, std::make_pair(window, Event::Show));
+                }
+            } else if (decision == ThrashDecision::Backoff) {
+                events.emplace(guard.RetryAt(window, pid), std::make_pair(window, Event::Retry));
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(AllowedAttemptsNeverExceedBurst) {
+    ThrashGuard guard;
+    Clock::time_point now = kStart;
+    // Faster than any refill: only the burst gets through
+    auto decisions = Hammer(guard, now, milliseconds(1), 50);
+    CHECK_EQ(Count(decisions, ThrashDecision::Allow), static_cast<size_t>(guard.Policy().windowBurst));
+    for (size_t i = 0; i < 3; i++) CHECK(decisions[i] == ThrashDecision::Allow);
+    CHECK(decisions[3] == ThrashDecision::Backoff);
+
+    // Many windows of one process share the process budget
+    ThrashGuard shared;
+    size_t allowed = 0;
+    for (uint64_t w = 1; w <= 50; w++) allowed += shared.OnHideAttempt(w, kPid, kStart) == ThrashDecision::Allow;
+    CHECK_EQ(allowed, static_cast<size_t>(shared.Policy().processBurst));
+    CHECK_EQ(shared.Stats().allowed, allowed);
+}
+
+TEST(BackoffDoublesUpToMax) {
+    ThrashPolicy policy;
+    policy.maxStrikes = 8;
+    policy.maxBackoff = milliseconds(4000);
+    policy.windowRefill = std::chrono::hours(1);  // No tokens come back during the test
+    ThrashGuard guard(policy);
+
+    Clock::time_point now = kStart;
+    for (int i = 0; i < 3; i++) CHECK(guard.OnHideAttempt(kWindow, 0, now) == ThrashDecision::Allow);
+
+    // Strikes 1-7 block for twice as long as the last one, capped at maxBackoff. An attempt
+    // 1 ms before a block ends must not strike, or the quarantine below would come early.
+    std::vector<milliseconds> expected = { milliseconds(500),  milliseconds(1000), milliseconds(2000),
+                                           milliseconds(4000), milliseconds(4000), milliseconds(4000),
+                                           milliseconds(4000) };
+    for (milliseconds backoff : expected) {
+        CHECK(guard.OnHideAttempt(kWindow, 0, now) == ThrashDecision::Backoff);
+        CHECK(guard.OnHideAttempt(kWindow, 0, now + backoff - milliseconds(1)) == ThrashDecision::Backoff);
+        now += backoff;
+    }
+    CHECK_EQ(guard.Stats().quarantines, 0u);
+    CHECK(guard.OnHideAttempt(kWindow, 0, now) == ThrashDecision::Quarantine);
+}
+
+TEST(QuarantinesOnceAfterMaxStrikes) {
+    ThrashGuard guard;
+    const ThrashPolicy& policy = guard.Policy();
+    Clock::time_point now = kStart;
+
+    // Ten attempts a second for a minute
+    std::vector<ThrashDecision> decisions = Hammer(guard, now, milliseconds(100), 600);
+    CHECK_EQ(Count(decisions, ThrashDecision::Quarantine), 1u);
+    CHECK_EQ(guard.Stats().quarantines, 1u);
+    CHECK(guard.IsQuarantined(kWindow, kPid, now));
+    CHECK_EQ(guard.QuarantinedWindows(now), 1u);
+    CHECK_EQ(guard.QuarantinedProcesses(now), 0u);
+
+    // Every attempt after it is suppressed; before it only burst plus refill got through
+    size_t quarantineAt = 0;
+    while (quarantineAt < decisions.size() && decisions[quarantineAt] != ThrashDecision::Quarantine) quarantineAt++;
+    CHECK(quarantineAt < decisions.size());
+    for (size_t i = quarantineAt + 1; i < decisions.size(); i++) CHECK(decisions[i] == ThrashDecision::Suppress);
+    CHECK_EQ(guard.Stats().suppressed, decisions.size() - quarantineAt - 1);
+    CHECK_EQ(guard.Stats().backoffs, Count(decisions, ThrashDecision::Backoff));
+
+    auto elapsed = milliseconds(100) * quarantineAt;
+    CHECK(Count(decisions, ThrashDecision::Allow) <= policy.windowBurst + elapsed / policy.windowRefill);
+}
+
+TEST(QuarantineExpires) {
+    ThrashGuard guard;
+    Clock::time_point now = kStart;
+    ThrashDecision decision = ThrashDecision::Allow;
+    while (decision != ThrashDecision::Quarantine) {
+        decision = guard.OnHideAttempt(kWindow, kPid, now);
+        now += milliseconds(100);
+    }
+    Clock::time_point quarantinedAt = now - milliseconds(100);
+    Clock::time_point expires = quarantinedAt + guard.Policy().quarantine;
+
+    CHECK(guard.OnHideAttempt(kWindow, kPid, expires - milliseconds(1)) == ThrashDecision::Suppress);
+    CHECK(guard.IsQuarantined(kWindow, kPid, expires - milliseconds(1)));
+    CHECK(!guard.IsQuarantined(kWindow, kPid, expires));
+    CHECK(guard.OnHideAttempt(kWindow, kPid, expires) == ThrashDecision::Allow);
+    CHECK_EQ(guard.QuarantinedWindows(expires), 0u);
+}
+
+TEST(RetryAtIsAllowed) {
+    ThrashGuard guard;
+    Clock::time_point now = kStart;
+    for (int i = 0; i < 3; i++) guard.OnHideAttempt(kWindow, kPid, now);
+    CHECK(guard.OnHideAttempt(kWindow, kPid, now) == ThrashDecision::Backoff);
+
+    // The backoff alone (500 ms) is not enough: the window also needs a token back (2 s)
+    Clock::time_point retry = guard.RetryAt(kWindow, kPid);
+    CHECK(retry - now == guard.Policy().windowRefill);
+    CHECK(guard.OnHideAttempt(kWindow, kPid, retry) == ThrashDecision::Allow);
+    CHECK_EQ(guard.Stats().quarantines, 0u);
+
+    // Unknown windows can go at once
+    CHECK(guard.RetryAt(99, 0) == Clock::time_point{});
+}
+
+TEST(PruneKeepsActiveEntries) {
+    ThrashGuard guard;
+    Clock::time_point now = kStart;
+
+    guard.OnHideAttempt(1, 10, now);  // One hide: idle again once the token refills
+    for (int i = 0; i < 4; i++) guard.OnHideAttempt(2, 20, now);  // Struck and backed off
+    Clock::time_point quarantined = now;
+    for (ThrashDecision d = ThrashDecision::Allow; d != ThrashDecision::Quarantine; quarantined += milliseconds(100)) {
+        d = guard.OnHideAttempt(3, 30, quarantined);
+    }
+    CHECK_EQ(guard.TrackedCount(), 6u);
+
+    // Nothing is idle while tokens are missing
+    guard.Prune(now + milliseconds(100));
+    CHECK_EQ(guard.TrackedCount(), 6u);
+
+    // Window 1 and every process budget have refilled; window 2 still carries its strike
+    guard.Prune(now + std::chrono::seconds(30));
+    CHECK_EQ(guard.TrackedCount(), 2u);
+    CHECK(guard.IsQuarantined(3, 0, now + std::chrono::seconds(30)));
+
+    // The strike decays, the quarantine does not
+    guard.Prune(now + std::chrono::minutes(2));
+    CHECK_EQ(guard.TrackedCount(), 1u);
+    CHECK(guard.IsQuarantined(3, 0, now + std::chrono::minutes(2)));
+
+    guard.Prune(quarantined + guard.Policy().quarantine);
+    CHECK_EQ(guard.TrackedCount(), 0u);
+}
+
+TEST(ManyWindowsShownOnceAreAllHidden) {
+    // A session restore: one program opens far more windows than its burst, each shown once
+    AutoMinimizeLoop loop;
+    const size_t windows = static_cast<size_t>(loop.guard.Policy().processBurst) * 3;
+    for (uint64_t w = 1; w <= windows; w++) loop.Show(w, kPid, kStart + milliseconds(w));
+    loop.RunUntil(kStart + std::chrono::minutes(1));
+
+    CHECK_EQ(loop.hidden.size(), windows);
+    CHECK(loop.events.empty());
+    CHECK_EQ(loop.guard.Stats().quarantines, 0u);
+    CHECK_EQ(loop.guard.Stats().suppressed, 0u);
+    CHECK(!loop.guard.IsQuarantined(1, kPid, kStart + std::chrono::minutes(1)));
+}
+
+TEST(RetriesNeverStrike) {
+    ThrashPolicy policy;
+    policy.windowRefill = std::chrono::hours(1);
+    ThrashGuard guard(policy);
+    for (int i = 0; i < 3; i++) guard.OnHideAttempt(kWindow, 0, kStart);
+
+    // Far more retries than maxStrikes, none of them a re-show
+    for (int i = 0; i < 100; i++) {
+        CHECK(guard.OnRetry(kWindow, 0, kStart + milliseconds(i)) == ThrashDecision::Backoff);
+    }
+    CHECK_EQ(guard.Stats().quarantines, 0u);
+    CHECK(!guard.IsQuarantined(kWindow, 0, kStart + milliseconds(100)));
+}
+
+TEST(ReshowingWindowsStillQuarantine) {
+    // One window re-shows itself right after every hide, retries included
+    AutoMinimizeLoop single;
+    single.thrashing = { kWindow };
+    single.Show(kWindow, kPid, kStart);
+    single.RunUntil(kStart + std::chrono::minutes(1));
+    CHECK_EQ(single.guard.Stats().quarantines, 1u);
+    CHECK(single.guard.IsQuarantined(kWindow, kPid, kStart + std::chrono::minutes(1)));
+    CHECK(!single.guard.IsProcessQuarantined(kPid, kStart + std::chrono::minutes(1)));
+
+    // Many windows of one program take turns: the program is quarantined as a whole
+    AutoMinimizeLoop many;
+    for (uint64_t w = 1; w <= 40; w++) {
+        many.thrashing.insert(w);
+        many.Show(w, kPid, kStart + milliseconds(w));
+    }
+    many.RunUntil(kStart + std::chrono::minutes(1));
+    CHECK(many.guard.IsProcessQuarantined(kPid, kStart + std::chrono::minutes(1)));
+}
@@ -0,0 +1,112 @@
+#include "tray_rebuild.h"
+
+#include <map>
+#include <set>
+
+#include "check.h"
+
+namespace {
+
+using Clock = TrayRebuild::Clock;
+using std::chrono::milliseconds;
+
+const Clock::time_point kStart = Clock::time_point{} + std::chrono::hours(1);
+constexpr milliseconds kInterval{ 15 };  // TRAY_REBUILD_INTERVAL_MS
+
+// Shell stand-in: rejects the first attempt of every tenth icon, always rejects
+// the icons in `broken`, and reports the icons in `gone` as restored meanwhile
+struct FakeTray {
+    std::set<uint64_t> broken;
+    std::set<uint64_t> gone;
+    std::map<uint64_t, int> attempts;
+    std::set<uint64_t> shown;
+
+    TrayAddResult Add(uint64_t id) {
+        int attempt = ++attempts[id];
+        if (gone.count(id)) return TrayAddResult::Gone;
+        if (broken.count(id) || (id % 10 == 0 && attempt == 1)) return TrayAddResult::Failed;
+        shown.insert(id);
+        return TrayAddResult::Added;
+    }
+};
+
+std::vector<uint64_t> Icons(uint64_t count) {
+    std::vector<uint64_t> icons;
+    for (uint64_t i = 0; i < count; i++) icons.push_back(i);
+    return icons;
+}
+
+// Steps like the app: once right away, then every 15 ms until done
+size_t RunToCompletion(TrayRebuild& rebuild, FakeTray& tray, Clock::time_point& now) {
+    auto add = [&](uint64_t id) { return tray.Add(id); };
+    size_t steps = 1;
+    while (!rebuild.Step(add, now)) {
+        now += kInterval;
+        steps++;
+    }
+    return steps;
+}
+
+} // namespace
+
+TEST(RetriesFailedIconsAndReportsTotals) {
+    FakeTray tray;
+    tray.broken = { 7 };
+    tray.gone = { 3 };
+    TrayRebuild rebuild(64, 5);
+    auto now = kStart;
+    rebuild.Begin(Icons(500), now);
+    size_t steps = RunToCompletion(rebuild, tray, now);
+
+    const TrayRebuildReport& report = rebuild.Report();
+    CHECK(!rebuild.Active());
+    CHECK_EQ(report.restored, 498u);
+    CHECK_EQ(report.failed, 1u);
+    CHECK_EQ(report.gone, 1u);
+    CHECK_EQ(tray.shown.size(), 498u);
+
+    // First pass: 8 bursts of 64; one retry pass for the tenth icons; then
+    // icon 7 alone until its 5 attempts are used up
+    CHECK_EQ(tray.attempts[7], 5);
+    CHECK_EQ(tray.attempts[10], 2);
+    CHECK_EQ(tray.attempts[11], 1);
+    CHECK_EQ(tray.attempts[3], 1);  // Gone is not retried
+    CHECK_EQ(steps, 12u);
+    CHECK_EQ(report.steps, steps);
+    CHECK(report.elapsed == kInterval * (steps - 1));
+}
+
+TEST(BurstLimitsAddsPerStep) {
+    FakeTray tray;
+    TrayRebuild rebuild(64, 5);
+    rebuild.Begin(Icons(100), kStart);
+    CHECK(!rebuild.Step([&](uint64_t id) { return tray.Add(id); }, kStart));
+    CHECK_EQ(tray.attempts.size(), 64u);
+    CHECK(rebuild.Active());
+}
+
+TEST(RestartMidRebuildStartsOver) {
+    FakeTray tray;
+    TrayRebuild rebuild(64, 5);
+    auto now = kStart;
+    rebuild.Begin(Icons(200), now);
+    rebuild.Step([&](uint64_t id) { return tray.Add(id); }, now);
+
+    // The shell died again: a new rebuild replaces the old report
+    now += milliseconds(500);
+    rebuild.Begin(Icons(200), now);
+    tray.attempts.clear();
+    size_t steps = RunToCompletion(rebuild, tray, now);
+
+    CHECK_EQ(rebuild.Report().restored, 200u);
+    CHECK_EQ(rebuild.Report().failed, 0u);
+    CHECK(rebuild.Report().elapsed == kInterval * (steps - 1));
+}
+
+TEST(EmptyRebuildFinishesImmediately) {
+    TrayRebuild rebuild;
+    rebuild.Begin({}, kStart);
+    CHECK(rebuild.Step([](uint64_t) { return TrayAddResult::Added; }, kStart));
+    CHECK_EQ(rebuild.Report().restored, 0u);
+    CHECK(rebuild.Report().elapsed == milliseconds(0));
+}
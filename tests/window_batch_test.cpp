@@ -0,0 +1,151 @@
+#include "window_batch.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "check.h"
+
+namespace {
+
+// Records every backend call in order as "add:<w>", "ops:<h|s><w>,...", "remove:<w>", "commit"
+struct RecordingBackend : BatchBackend {
+    std::set<uint64_t> hidden;
+    std::set<uint64_t> refuseAdd;
+    std::vector<std::string> calls;
+
+    bool AddTrayIcon(uint64_t window) override {
+        calls.push_back("add:" + std::to_string(window));
+        if (refuseAdd.count(window) || hidden.count(window)) return false;
+        hidden.insert(window);
+        return true;
+    }
+    bool RemoveTrayIcon(uint64_t window) override {
+        calls.push_back("remove:" + std::to_string(window));
+        return hidden.erase(window) > 0;
+    }
+    void ApplyWindowOps(const std::vector<WindowOp>& ops) override {
+        std::string call = "ops:";
+        for (const auto& op : ops) {
+            if (call.size() > 4) call += ",";
+            call += op.kind == WindowOpKind::Hide ? 'h' : 's';
+            call += std::to_string(op.window);
+        }
+        calls.push_back(call);
+    }
+    void CommitState() override { calls.push_back("commit"); }
+
+    size_t Commits() const {
+        size_t n = 0;
+        for (const auto& call : calls) n += call == "commit";
+        return n;
+    }
+};
+
+using Calls = std::vector<std::string>;
+
+} // namespace
+
+TEST(HideBatchAddsTrayIconsBeforeHidingAndWritesOnce) {
+    RecordingBackend backend;
+    WindowBatch batch;
+    batch.Hide(1);
+    batch.Hide(2);
+    batch.Hide(3);
+    BatchResult result = batch.Commit(backend);
+
+    CHECK(backend.calls == (Calls{ "add:1", "add:2", "add:3", "ops:h1,h2,h3", "commit" }));
+    CHECK_EQ(result.hidden, 3u);
+    CHECK_EQ(result.skipped, 0u);
+    CHECK(batch.Empty());
+}
+
+TEST(MixedBatchRunsAddsOpsRemovesCommitInOrder) {
+    RecordingBackend backend;
+    backend.hidden = { 10, 11, 12 };
+    WindowBatch batch;
+    batch.Restore(10);
+    batch.Hide(1);
+    batch.Forget(11);
+    batch.Hide(2);
+    batch.Restore(12);
+    BatchResult result = batch.Commit(backend);
+
+    // Adds, then one grouped show/hide, then deletes, then a single state write
+    CHECK(backend.calls == (Calls{ "add:1", "add:2", "ops:h1,h2,s10,s12", "remove:10", "remove:11", "remove:12", "commit" }));
+    CHECK_EQ(result.hidden, 2u);
+    CHECK_EQ(result.restored, 2u);
+    CHECK_EQ(result.forgotten, 1u);
+    CHECK_EQ(backend.Commits(), 1u);
+}
+
+TEST(EmptyBatchTouchesNothing) {
+    RecordingBackend backend;
+    WindowBatch batch;
+    BatchResult result = batch.Commit(backend);
+    CHECK(backend.calls.empty());
+    CHECK_EQ(result.hidden + result.restored + result.forgotten + result.skipped, 0u);
+}
+
+TEST(AllSkippedBatchDoesNotWriteState) {
+    RecordingBackend backend;
+    backend.refuseAdd = { 1 };
+    backend.hidden = { 2 };
+    WindowBatch batch;
+    batch.Hide(1);    // Tray refuses the icon
+    batch.Hide(2);    // Already hidden
+    batch.Forget(3);  // Never hidden
+    BatchResult result = batch.Commit(backend);
+
+    CHECK_EQ(result.skipped, 3u);
+    CHECK_EQ(backend.Commits(), 0u);
+    // Skipped hides are not applied to the window either
+    CHECK(backend.calls == (Calls{ "add:1", "add:2", "remove:3" }));
+}
+
+TEST(RestagingReplacesEarlierAction) {
+    RecordingBackend backend;
+    backend.hidden = { 5 };
+    WindowBatch batch;
+    batch.Hide(7);
+    batch.Restore(7);  // Hide then restore: only the restore remains
+    batch.Restore(5);
+    batch.Forget(5);   // Restore then forget: only the forget remains
+    CHECK_EQ(batch.Size(), 2u);
+
+    BatchResult result = batch.Commit(backend);
+    CHECK(backend.calls == (Calls{ "ops:s7", "remove:7", "remove:5", "commit" }));
+    CHECK_EQ(result.forgotten, 1u);
+    CHECK_EQ(result.restored, 0u);
+    CHECK_EQ(result.skipped, 1u);
+}
+
+TEST(EachCommitWritesStateOnce) {
+    RecordingBackend backend;
+    WindowBatch batch;
+    for (uint64_t w = 0; w < 100; w++) batch.Hide(w);
+    batch.Commit(backend);
+    for (uint64_t w = 0; w < 100; w++) batch.Restore(w);
+    batch.Commit(backend);
+    CHECK_EQ(backend.Commits(), 2u);
+    CHECK(backend.hidden.empty());
+}
+
+TEST(RehideHidesWithoutTrayOrStateChanges) {
+    RecordingBackend backend;
+    backend.hidden = { 4 };
+    WindowBatch batch;
+    batch.Rehide(4);
+    BatchResult result = batch.Commit(backend);
+
+    CHECK(backend.calls == (Calls{ "ops:h4" }));
+    CHECK_EQ(result.rehidden, 1u);
+    CHECK_EQ(result.hidden + result.skipped, 0u);
+    CHECK(backend.hidden.count(4));
+
+    // Grouped with other work it joins the same ops call and adds no state write of its own
+    batch.Hide(8);
+    batch.Rehide(4);
+    batch.Commit(backend);
+    CHECK(backend.calls == (Calls{ "ops:h4", "add:8", "ops:h8,h4", "commit" }));
+}
@@ -0,0 +1,116 @@
+#include "window_reaper.h"
+
+#include <algorithm>
+
+#include "check.h"
+
+namespace {
+
+using Clock = WindowReaper::Clock;
+using std::chrono::milliseconds;
+
+const Clock::time_point kStart = Clock::time_point{} + std::chrono::hours(1);
+
+template <typename T>
+std::vector<T> Sorted(std::vector<T> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace
+
+TEST(TrackReportsFirstWindowOfProcess) {
+    WindowReaper reaper;
+    CHECK(reaper.Track(0x10, 7));
+    CHECK(!reaper.Track(0x20, 7));
+    CHECK(!reaper.Track(0x10, 7));  // Already tracked
+    CHECK(reaper.Track(0x30, 8));
+    CHECK_EQ(reaper.TrackedCount(), 3u);
+}
+
+TEST(BulkExitSignalsOneFlush) {
+    // 2000 windows across 500 processes, every process exits at once
+    WindowReaper reaper;
+    for (uint64_t w = 0; w < 2000; w++) reaper.Track(0x1000 + w, 100 + static_cast<uint32_t>(w % 500));
+
+    int flushSignals = 0;
+    for (uint32_t p = 0; p < 500; p++) {
+        if (reaper.OnProcessExited(100 + p, kStart + milliseconds(p))) flushSignals++;
+    }
+    // Late window-destroyed events for windows already pending do not signal again
+    for (uint64_t w = 0; w < 2000; w++) {
+        if (reaper.OnWindowDestroyed(0x1000 + w, kStart + milliseconds(600))) flushSignals++;
+    }
+    CHECK_EQ(flushSignals, 1);
+    CHECK_EQ(reaper.PendingCount(), 2000u);
+
+    ReapBatch batch = reaper.TakeBatch(kStart + milliseconds(1000));
+    CHECK_EQ(batch.windows.size(), 2000u);
+    CHECK_EQ(batch.releasedProcesses.size(), 500u);
+    CHECK_EQ(reaper.TrackedCount(), 0u);
+    CHECK_EQ(reaper.PendingCount(), 0u);
+
+    // Latency is measured from each window's mark to the flush
+    const ReapStats& stats = reaper.Stats();
+    CHECK_EQ(stats.batches, 1u);
+    CHECK_EQ(stats.reapedWindows, 2000u);
+    CHECK(stats.maxLatency == milliseconds(1000));
+    CHECK(stats.totalLatency > milliseconds(0));
+    CHECK(stats.totalLatency < stats.maxLatency * 2000);
+}
+
+TEST(NextMarkAfterFlushSignalsAgain) {
+    WindowReaper reaper;
+    reaper.Track(0x10, 7);
+    reaper.Track(0x20, 8);
+    CHECK(reaper.OnWindowDestroyed(0x10, kStart));
+    reaper.TakeBatch(kStart);
+    CHECK(reaper.OnWindowDestroyed(0x20, kStart));
+    CHECK(reaper.TakeBatch(kStart).windows == std::vector<uint64_t>{ 0x20 });
+}
+
+TEST(UntrackRemovesPendingWindowFromBatch) {
+    WindowReaper reaper;
+    reaper.Track(0x10, 7);
+    reaper.Track(0x20, 7);
+    reaper.Track(0x30, 8);
+    reaper.OnProcessExited(7, kStart);
+    reaper.OnWindowDestroyed(0x30, kStart);
+
+    // Restored by the user before the flush ran; 0x20 still holds process 7
+    CHECK(!reaper.Untrack(0x10).has_value());
+    CHECK(!reaper.IsTracked(0x10));
+
+    ReapBatch batch = reaper.TakeBatch(kStart);
+    CHECK(Sorted(batch.windows) == (std::vector<uint64_t>{ 0x20, 0x30 }));
+    CHECK(Sorted(batch.releasedProcesses) == (std::vector<uint32_t>{ 7, 8 }));
+}
+
+TEST(ReleasedProcessesOnlyWhenLastWindowGoes) {
+    WindowReaper reaper;
+    reaper.Track(0x10, 7);
+    reaper.Track(0x20, 7);
+    reaper.Track(0x30, 9);
+
+    // One of two windows of process 7 destroyed: its wait must stay
+    reaper.OnWindowDestroyed(0x10, kStart);
+    ReapBatch batch = reaper.TakeBatch(kStart);
+    CHECK(batch.windows == std::vector<uint64_t>{ 0x10 });
+    CHECK(batch.releasedProcesses.empty());
+
+    // Restoring the last window releases the process through Untrack instead
+    auto released = reaper.Untrack(0x20);
+    CHECK(released.has_value() && *released == 7u);
+    CHECK(!reaper.OnProcessExited(7, kStart));
+    CHECK(reaper.IsTracked(0x30));
+}
+
+TEST(UnknownEventsAreIgnored) {
+    WindowReaper reaper;
+    CHECK(!reaper.OnWindowDestroyed(0x99, kStart));
+    CHECK(!reaper.OnProcessExited(42, kStart));
+    CHECK(!reaper.Untrack(0x99).has_value());
+    ReapBatch batch = reaper.TakeBatch(kStart);
+    CHECK(batch.windows.empty());
+    CHECK_EQ(reaper.Stats().batches, 0u);
+}